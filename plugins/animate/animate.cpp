@@ -42,7 +42,7 @@ class animation_hook : public wf::custom_data_t
     }
 
     /* Update animation right before each frame */
-    wf::effect_hook_t update_animation_hook = [=] ()
+    wf::animation_hook_t update_animation_hook = [=] (int64_t)
     {
         damage_whole_view();
         bool result = animation->step();
@@ -52,6 +52,8 @@ class animation_hook : public wf::custom_data_t
         {
             stop_hook(false);
         }
+
+        return result;
     };
 
     /**
@@ -62,13 +64,12 @@ class animation_hook : public wf::custom_data_t
     {
         if (current_output)
         {
-            current_output->render->rem_effect(&update_animation_hook);
+            current_output->render->rem_animation(&update_animation_hook);
         }
 
         if (new_output)
         {
-            new_output->render->add_effect(&update_animation_hook,
-                wf::OUTPUT_EFFECT_PRE);
+            new_output->render->add_animation(&update_animation_hook);
         }
 
         current_output = new_output;
@@ -117,7 +118,8 @@ class animation_hook : public wf::custom_data_t
     {
         if (!unmapped_contents)
         {
-            unmapped_contents = std::make_shared<wf::unmapped_view_snapshot_node>(view);
+            unmapped_contents = std::make_shared<wf::unmapped_view_snapshot_node>(view,
+                animation->get_snapshot_scale());
             auto parent = dynamic_cast<wf::scene::floating_inner_node_t*>(
                 view->get_surface_root_node()->parent());
 
@@ -201,6 +203,9 @@ class wayfire_animation : public wf::plugin_interface_t, private wf::per_output_
     wf::view_matcher_t fire_enabled_for{"animate/fire_enabled_for"};
 
     wf::shared_data::ref_ptr_t<wf::animate::animate_effects_registry_t> effects_registry;
+    // Keeps the snapshot buffer pool alive between close animations, the snapshot nodes hold it only while
+    // they exist.
+    wf::shared_data::ref_ptr_t<wf::snapshot_buffer_pool_t> snapshot_pool;
 
     template<class animation_t>
     void register_effect(std::string name, wf::option_sptr_t<wf::animation_description_t> option)
@@ -383,6 +388,13 @@ class wayfire_animation : public wf::plugin_interface_t, private wf::per_output_
         [=] (wf::view_pre_unmap_signal *ev)
     {
         auto animation = get_animation_for_view(close_animation, ev->view);
+        if (!wf::is_view_visible_on_output(ev->view))
+        {
+            // Nobody would see the animation, so do not bother taking a snapshot of the view.
+            ev->view->erase_data(get_map_animation_cdata_name(animation.animation_name));
+            return;
+        }
+
         set_animation(ev->view, animation.animation_name,
             wf::animate::ANIMATION_TYPE_UNMAP, animation.duration);
     };
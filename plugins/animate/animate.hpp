@@ -42,6 +42,15 @@ class animation_base_t
     virtual void reverse()
     {}
 
+    /**
+     * @return The resolution of the unmap snapshot relative to the output. Effects which distort or shrink
+     *   the view can use a lower resolution to save memory and copies.
+     */
+    virtual float get_snapshot_scale() const
+    {
+        return 1.0;
+    }
+
     virtual ~animation_base_t() = default;
 };
 
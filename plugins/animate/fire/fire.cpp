@@ -17,14 +17,6 @@ static wf::option_wrapper_t<double> fire_particle_size{"animate/fire_particle_si
 static wf::option_wrapper_t<bool> random_fire_color{"animate/random_fire_color"};
 static wf::option_wrapper_t<wf::color_t> fire_color{"animate/fire_color"};
 
-// generate a random float between s and e
-static float random(float s, float e)
-{
-    double r = 1.0 * (std::rand() % RAND_MAX) / (RAND_MAX - 1);
-
-    return (s * r + (1 - r) * e);
-}
-
 static int particle_count_for_width(int width)
 {
     int particles = fire_particles;
@@ -32,6 +24,17 @@ static int particle_count_for_width(int width)
     return particles * std::min(width / 400.0, 3.5);
 }
 
+/* Everything needed to initialize new particles.
+ * Particles are initialized in parallel, so this is captured once before spawning. */
+struct fire_spawn_params_t
+{
+    wf::geometry_t bounding_box;
+    double progress;
+    wf::color_t color;
+    bool random_color;
+    double particle_size;
+};
+
 class fire_node_t : public wf::scene::floating_inner_node_t
 {
   public:
@@ -40,25 +43,39 @@ class fire_node_t : public wf::scene::floating_inner_node_t
     {
         ps = std::make_unique<ParticleSystem>(1);
         ps->set_initer(
-            [=] (Particle& p)
+            [=] (Particle& p, ParticleRandom& random)
         {
-            init_particle_with_node(p, get_children_bounding_box(), progress_line);
+            init_particle_with_node(p, random, spawn_params);
         });
     }
 
-    static void init_particle_with_node(Particle& p,
-        wf::geometry_t bounding_box, double progress)
+    /* Spawn new particles at the current progress line */
+    void spawn(int num)
     {
+        spawn_params.bounding_box  = get_children_bounding_box();
+        spawn_params.progress      = progress_line;
+        spawn_params.color         = fire_color;
+        spawn_params.random_color  = random_fire_color;
+        spawn_params.particle_size = fire_particle_size;
+        ps->spawn(num);
+    }
+
+    static void init_particle_with_node(Particle& p, ParticleRandom& rng,
+        const fire_spawn_params_t& params)
+    {
+        auto random = [&] (float s, float e) { return rng.uniform(s, e); };
+        const auto& bounding_box = params.bounding_box;
+
         p.life = 1;
         p.fade = random(0.1, 0.6);
 
-        wf::color_t color_setting = fire_color;
+        wf::color_t color_setting = params.color;
 
         float r;
         float g;
         float b;
 
-        if (!random_fire_color)
+        if (!params.random_color)
         {
             // The calculation here makes the variation lower at darker values
             float randomize_amount_r = (color_setting.r * 0.857) / 2;
@@ -87,13 +104,13 @@ class fire_node_t : public wf::scene::floating_inner_node_t
 
         p.color = {r, g, b, 1};
 
-        const double cur_pos = bounding_box.height * progress;
+        const double cur_pos = bounding_box.height * params.progress;
         p.pos = {random(0, bounding_box.width), random(cur_pos - 10, cur_pos + 10)};
         p.start_pos = p.pos;
         p.speed     = {random(-10, 10), random(-25, 5)};
         p.g = {-1, -3};
 
-        double size = fire_particle_size;
+        double size = params.particle_size;
         p.base_radius = p.radius = random(size * 0.8, size * 1.2);
     }
 
@@ -127,6 +144,9 @@ class fire_node_t : public wf::scene::floating_inner_node_t
     {
         progress_line = line;
     }
+
+  private:
+    fire_spawn_params_t spawn_params;
 };
 
 class fire_render_instance_t : public wf::scene::render_instance_t
@@ -261,7 +281,7 @@ bool FireAnimation::step()
     transformer->set_progress_line(this->progression);
     if (this->progression.running())
     {
-        transformer->ps->spawn(transformer->ps->size() / 10);
+        transformer->spawn(transformer->ps->size() / 10);
     }
 
     transformer->ps->update();
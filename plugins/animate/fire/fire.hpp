@@ -20,6 +20,12 @@ class FireAnimation : public wf::animate::animation_base_t
     void init(wayfire_view view, wf::animation_description_t, wf::animate::animation_type type) override;
     bool step() override; /* return true if continue, false otherwise */
     void reverse() override; /* reverse the animation */
+
+    float get_snapshot_scale() const override
+    {
+        // The view is mostly covered by particles while burning.
+        return 0.5;
+    }
 };
 
 #endif /* end of include guard: FIRE_ANIMATION_HPP */
@@ -0,0 +1,165 @@
+#include "particle.hpp"
+#include <algorithm>
+#include <cmath>
+
+static uint64_t splitmix64(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ull;
+    x  = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x  = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+ParticleRandom::ParticleRandom(uint64_t seed, uint64_t stream)
+{
+    key = splitmix64(seed ^ splitmix64(stream));
+}
+
+float ParticleRandom::uniform(float s, float e)
+{
+    // 24 random bits give a uniformly distributed float in [0, 1]
+    uint64_t bits = splitmix64(key + counter++) >> 40;
+    float r = bits / float((1 << 24) - 1);
+
+    return s * r + (1 - r) * e;
+}
+
+ParticleBuffer::ParticleBuffer(uint64_t seed) : seed(seed)
+{}
+
+void ParticleBuffer::set_initer(ParticleIniter init)
+{
+    this->pinit_func = init;
+}
+
+void ParticleBuffer::store(int i, const Particle& p)
+{
+    life[i] = p.life;
+    fade[i] = p.fade;
+    radius[i]  = p.radius;
+    base_radius[i] = p.base_radius;
+    x[i] = p.pos.x;
+    y[i] = p.pos.y;
+    speed_x[i] = p.speed.x;
+    speed_y[i] = p.speed.y;
+    g_x[i] = p.g.x;
+    g_y[i] = p.g.y;
+    start_x[i] = p.start_pos.x;
+    r[i] = p.color.r;
+    g[i] = p.color.g;
+    b[i] = p.color.b;
+    a[i] = p.color.a;
+}
+
+void ParticleBuffer::move(int from, int to)
+{
+    for (auto array : {&life, &fade, &radius, &base_radius, &x, &y, &speed_x, &speed_y,
+        &g_x, &g_y, &start_x, &r, &g, &b, &a})
+    {
+        (*array)[to] = (*array)[from];
+    }
+}
+
+int ParticleBuffer::spawn(int num)
+{
+    num = std::clamp(num, 0, capacity - count);
+
+    const int first = count;
+    const uint64_t first_stream = spawned_total;
+
+    // Each particle has its own random stream, so the result does not depend
+    // on how the loop is split between threads.
+#   pragma omp parallel for
+    for (int i = 0; i < num; i++)
+    {
+        Particle p;
+        ParticleRandom random{seed, first_stream + i};
+        pinit_func(p, random);
+        store(first + i, p);
+    }
+
+    count += num;
+    spawned_total += num;
+    return num;
+}
+
+void ParticleBuffer::resize(int num)
+{
+    num = std::max(num, 0);
+    if (num == capacity)
+    {
+        return;
+    }
+
+    for (auto array : {&life, &fade, &radius, &base_radius, &x, &y, &speed_x, &speed_y,
+        &g_x, &g_y, &start_x, &r, &g, &b, &a})
+    {
+        array->resize(num);
+    }
+
+    capacity = num;
+    count    = std::min(count, num);
+}
+
+int ParticleBuffer::size() const
+{
+    return capacity;
+}
+
+int ParticleBuffer::alive() const
+{
+    return count;
+}
+
+void ParticleBuffer::update([[maybe_unused]] float time)
+{
+    const float slowdown = 0.8;
+    const int n = count;
+
+    float *px = x.data(), *py = y.data();
+    float *vx = speed_x.data(), *vy = speed_y.data();
+    float *gx = g_x.data();
+    const float *gy = g_y.data(), *sx = start_x.data();
+    float *l  = life.data(), *alpha = a.data(), *rad = radius.data();
+    const float *f = fade.data(), *base = base_radius.data();
+
+    // No branches, so that the loop can be vectorized.
+#   pragma omp parallel for simd
+    for (int i = 0; i < n; i++)
+    {
+        px[i] += vx[i] * 0.2f * slowdown;
+        py[i] += vy[i] * 0.2f * slowdown;
+        vx[i] += gx[i] * 0.3f * slowdown;
+        vy[i] += gy[i] * 0.3f * slowdown;
+
+        const float old_life = l[i];
+        const float new_life = old_life - f[i] * 0.3f * slowdown;
+
+        alpha[i] = (old_life != 0 ? alpha[i] / old_life : alpha[i]) * new_life;
+        rad[i]   = base[i] * std::sqrt(std::max(new_life, 0.0f));
+        l[i]     = new_life;
+
+        gx[i] = (sx[i] < px[i]) ? -1.0f : 1.0f;
+    }
+
+    compact();
+}
+
+void ParticleBuffer::compact()
+{
+    int alive = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (life[i] > 0)
+        {
+            if (i != alive)
+            {
+                move(i, alive);
+            }
+
+            ++alive;
+        }
+    }
+
+    count = alive;
+}
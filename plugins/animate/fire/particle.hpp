@@ -3,9 +3,10 @@
 
 #include <wayfire/opengl.hpp>
 #include <functional>
-#include <atomic>
+#include <cstdint>
 #include <vector>
 
+/* The initial state of a particle, filled in by a ParticleIniter */
 struct Particle
 {
     float life = -1;
@@ -17,15 +18,71 @@ struct Particle
     glm::vec2 start_pos;
 
     glm::vec4 color{1.0, 1.0, 1.0, 1.0};
+};
 
-    /* update the given particle
-     * time is the percentage of the frame which has elapsed
-     * must be thread-safe */
-    void update(float time);
+/* A counter-based random number generator.
+ * The n-th number of a stream depends only on the seed, the stream and n,
+ * so particles can be initialized on any thread and in any order. */
+class ParticleRandom
+{
+  public:
+    ParticleRandom(uint64_t seed, uint64_t stream);
+
+    /* a random float between s and e */
+    float uniform(float s, float e);
+
+  private:
+    uint64_t key;
+    uint64_t counter = 0;
 };
 
-/* a function to initialize a particle */
-using ParticleIniter = std::function<void (Particle&)>;
+/* a function to initialize a particle
+ * it is called concurrently from several threads, so it must be thread-safe */
+using ParticleIniter = std::function<void (Particle&, ParticleRandom&)>;
+
+/* The particles of a particle system, stored as structure of arrays.
+ * Alive particles are always kept at the front of the arrays, so that
+ * the first alive() entries of each array can be used for rendering. */
+class ParticleBuffer
+{
+  public:
+    ParticleBuffer(uint64_t seed = 0);
+    void set_initer(ParticleIniter init);
+
+    /* spawn at most num new particles.
+     * returns the number of actually spawned particles */
+    int spawn(int num);
+
+    /* change the maximal number of particles
+     * Warning: This might kill a lot of particles */
+    void resize(int num);
+
+    // return the maximal number of particles
+    int size() const;
+
+    // number of particles alive
+    int alive() const;
+
+    /* update all particles and remove the dead ones
+     * time is the percentage of the frame which has elapsed */
+    void update(float time);
+
+    std::vector<float> life, fade;
+    std::vector<float> radius, base_radius;
+    std::vector<float> x, y, speed_x, speed_y, g_x, g_y, start_x;
+    std::vector<float> r, g, b, a;
+
+  private:
+    ParticleIniter pinit_func = [] (auto&, auto&) {};
+    uint64_t seed;
+    uint64_t spawned_total = 0;
+    int capacity = 0;
+    int count    = 0;
+
+    void store(int i, const Particle& p);
+    void move(int from, int to);
+    void compact();
+};
 
 class ParticleSystem
 {
@@ -66,23 +123,10 @@ class ParticleSystem
   private:
     ParticleSystem() = delete;
 
-    ParticleIniter pinit_func = [] (auto) {};
     uint32_t last_update_msec;
-
-    std::atomic<int> particles_alive;
-    std::vector<Particle> ps;
-
-    static constexpr int color_per_particle = 4;
-    std::vector<float> color, dark_color;
-
-    static constexpr int radius_per_particle = 1;
-    std::vector<float> radius;
-
-    static constexpr int center_per_particle = 2;
-    std::vector<float> center;
+    ParticleBuffer particles;
 
     OpenGL::program_t program;
-    void update_worker(float time, int i);
     void create_program();
 };
 
@@ -292,6 +292,11 @@ class squeezimize_transformer : public wf::scene::view_2d_transformer_t
         return this->animation_geometry;
     }
 
+    std::optional<wf::texture_t> to_texture() const override
+    {
+        return {};
+    }
+
     void gen_render_instances(std::vector<render_instance_uptr>& instances,
         damage_callback push_damage, wf::output_t *shown_on) override
     {
@@ -347,6 +352,12 @@ class squeezimize_animation : public animate::animation_base_t
         view->get_transformed_node()->rem_transformer(squeezimize_transformer_name);
     }
 
+    float get_snapshot_scale() const override
+    {
+        // The view is squeezed towards the minimize target during the whole animation.
+        return 0.5;
+    }
+
     bool step() override
     {
         auto tmgr = view->get_transformed_node();
@@ -1,26 +1,168 @@
 #pragma once
 
 #include "wayfire/geometry.hpp"
+#include "wayfire/output.hpp"
+#include "wayfire/region.hpp"
 #include "wayfire/scene-render.hpp"
 #include "wayfire/scene.hpp"
+#include "wayfire/view-helpers.hpp"
+#include "wayfire/view-transform.hpp"
+#include <wayfire/plugins/common/shared-core-data.hpp>
 #include <wayfire/view.hpp>
+#include <algorithm>
+#include <cmath>
 
 namespace wf
 {
+/**
+ * A pool of buffers for the snapshots of unmapped views, shared by all outputs.
+ *
+ * Buffers return to the pool when a close animation ends, so views closed one after another with the same
+ * size (for example terminals or dialogs) reuse the buffer of the previous one. Views closed at the same
+ * time still need one buffer each.
+ */
+class snapshot_buffer_pool_t
+{
+  public:
+    // The maximal number of free buffers which are kept around.
+    static constexpr size_t MAX_FREE_BUFFERS = 4;
+
+    /**
+     * Get a free buffer which already has the pixel size needed for a snapshot of the given size and scale,
+     * or an empty buffer if there is none. The buffer still has to be allocated with the desired size.
+     */
+    wf::auxilliary_buffer_t acquire(wf::dimensions_t size, float scale)
+    {
+        if (free_buffers.empty())
+        {
+            return {};
+        }
+
+        const wf::dimensions_t pixel_size = {
+            (int)std::max(1.0f, std::ceil(size.width * scale)),
+            (int)std::max(1.0f, std::ceil(size.height * scale)),
+        };
+
+        auto it = std::find_if(free_buffers.begin(), free_buffers.end(), [&] (const auto& buffer)
+        {
+            return buffer.get_size() == pixel_size;
+        });
+
+        if (it == free_buffers.end())
+        {
+            // A buffer of another size would be reallocated anyway.
+            return {};
+        }
+
+        wf::auxilliary_buffer_t buffer = std::move(*it);
+        free_buffers.erase(it);
+        return buffer;
+    }
+
+    /**
+     * Return a buffer to the pool.
+     */
+    void release(wf::auxilliary_buffer_t&& buffer)
+    {
+        if (!buffer.get_buffer())
+        {
+            return;
+        }
+
+        if (free_buffers.size() >= MAX_FREE_BUFFERS)
+        {
+            free_buffers.erase(free_buffers.begin());
+        }
+
+        free_buffers.push_back(std::move(buffer));
+    }
+
+  private:
+    std::vector<wf::auxilliary_buffer_t> free_buffers;
+};
+
+/**
+ * Check whether any part of the view is visible on its output, that is, whether it is inside the output and
+ * not completely covered by opaque views above it.
+ *
+ * Only untransformed views are considered as occluders, since transformers may change the opaque region.
+ */
+inline bool is_view_visible_on_output(wayfire_view view)
+{
+    auto output = view->get_output();
+    if (!output)
+    {
+        return false;
+    }
+
+    wf::region_t visible{
+        wf::geometry_intersection(view->get_bounding_box(), output->get_relative_geometry())};
+    auto views = wf::collect_views_from_output(output, {
+        wf::scene::layer::DWIDGET, wf::scene::layer::LOCK, wf::scene::layer::OVERLAY,
+        wf::scene::layer::UNMANAGED, wf::scene::layer::TOP, wf::scene::layer::WORKSPACE,
+        wf::scene::layer::BOTTOM, wf::scene::layer::BACKGROUND,
+    });
+
+    for (auto& above : views)
+    {
+        if (visible.empty() || (above == view))
+        {
+            break;
+        }
+
+        if (!above->is_mapped() || above->has_transformer())
+        {
+            continue;
+        }
+
+        if (auto opaque = dynamic_cast<wf::scene::opaque_region_node_t*>(above->get_root_node().get()))
+        {
+            visible ^= opaque->get_opaque_region();
+        }
+    }
+
+    return !visible.empty();
+}
+
 class unmapped_view_snapshot_node : public wf::scene::node_t
 {
     wf::auxilliary_buffer_t snapshot;
     wf::dimensions_t snapshot_logical_size;
     std::weak_ptr<wf::view_interface_t> _view;
+    wf::shared_data::ref_ptr_t<snapshot_buffer_pool_t> pool;
 
   public:
-    unmapped_view_snapshot_node(wayfire_view view) : node_t(false)
+    /**
+     * @param scale The resolution of the snapshot relative to the view's output.
+     */
+    unmapped_view_snapshot_node(wayfire_view view, float scale = 1.0) : node_t(false)
     {
-        view->take_snapshot(snapshot);
-        snapshot_logical_size = wf::dimensions(view->get_surface_root_node()->get_bounding_box());
+        auto surface_root = view->get_surface_root_node();
+        snapshot_logical_size = wf::dimensions(surface_root->get_bounding_box());
+
+        // Fully opaque views do not need an alpha channel, and can be stored in a smaller format if the
+        // snapshot is scaled anyway.
+        wf::buffer_allocation_hints_t hints;
+        if (auto opaque = dynamic_cast<wf::scene::opaque_region_node_t*>(surface_root.get()))
+        {
+            wf::region_t translucent{surface_root->get_bounding_box()};
+            translucent ^= opaque->get_opaque_region();
+            hints.needs_alpha = !translucent.empty();
+        }
+
+        hints.low_precision = (scale < 1.0);
+
+        const float output_scale = view->get_output() ? view->get_output()->handle->scale : 1.0;
+        snapshot = pool->acquire(snapshot_logical_size, scale * output_scale);
+        view->take_snapshot(snapshot, scale, hints);
         _view = view->weak_from_this();
     }
 
+    ~unmapped_view_snapshot_node()
+    {
+        pool->release(std::move(snapshot));
+    }
+
     wf::geometry_t get_bounding_box() override
     {
         if (auto view = _view.lock())
@@ -51,6 +193,7 @@ class unmapped_view_snapshot_node : public wf::scene::node_t
         void render(const wf::scene::render_instruction_t& data)
         {
             wf::texture_t texture = wf::texture_t{self->snapshot.get_texture()};
+            texture.filter_mode = WLR_SCALE_FILTER_BILINEAR;
             data.pass->add_texture(texture, data.target, self->get_bounding_box(), data.damage);
         }
     };
@@ -66,6 +66,12 @@ class zap_animation : public animate::animation_base_t
             tr, wf::TRANSFORMER_HIGHLEVEL, zap_transformer_name);
     }
 
+    float get_snapshot_scale() const override
+    {
+        // The view is shrunk during the whole animation.
+        return 0.5;
+    }
+
     bool step() override
     {
         auto transform = view->get_transformed_node()
@@ -262,6 +262,14 @@ struct core_drag_t::impl
 
     std::shared_ptr<dragged_view_node_t> render_node;
 
+    // The latest drag position which has not been applied yet.
+    std::optional<wf::point_t> pending_position;
+    // The output on whose next frame the pending position will be applied.
+    wf::output_t *motion_output = nullptr;
+    // All positions received since the last drag motion signal.
+    std::vector<wf::point_t> raw_positions;
+    wf::animation_hook_t on_motion_frame;
+
     wf::effect_hook_t on_pre_frame = [=] ()
     {
         for (auto& v : this->all_views)
@@ -286,8 +294,21 @@ core_drag_t::core_drag_t()
         handle_input_released();
     };
 
+    priv->on_motion_frame = [=] (int64_t)
+    {
+        // The hook is removed after returning false.
+        priv->motion_output = nullptr;
+        flush_pending_motion();
+        return false;
+    };
+
     priv->on_output_removed = [=] (wf::output_removed_signal *ev)
     {
+        if (priv->motion_output == ev->output)
+        {
+            flush_pending_motion();
+        }
+
         if (current_output == ev->output)
         {
             update_current_output(nullptr);
@@ -297,7 +318,13 @@ core_drag_t::core_drag_t()
     wf::get_core().output_layout->connect(&priv->on_output_removed);
 }
 
-core_drag_t::~core_drag_t() = default;
+core_drag_t::~core_drag_t()
+{
+    if (priv->motion_output)
+    {
+        priv->motion_output->render->rem_animation(&priv->on_motion_frame);
+    }
+}
 
 void core_drag_t::rebuild_wobbly(wayfire_toplevel_view view, wf::point_t grab, wf::pointf_t relative)
 {
@@ -404,6 +431,50 @@ void core_drag_t::start_drag(wayfire_toplevel_view view, const drag_options_t& o
 }
 
 void core_drag_t::handle_motion(wf::point_t to)
+{
+    // Update wobbly independently of the grab position.
+    // This is because while held in place, wobbly is anchored to its edges
+    // so we can still move the grabbed point without moving the view.
+    for (auto& v : priv->all_views)
+    {
+        move_wobbly(v.view, to.x, to.y);
+    }
+
+    priv->raw_positions.push_back(to);
+    if (!current_output)
+    {
+        // The drag just started, position the views right away.
+        apply_motion(to);
+        return;
+    }
+
+    priv->pending_position = to;
+    if (!priv->motion_output)
+    {
+        wf::pointf_t origin = {1.0 * to.x, 1.0 * to.y};
+        auto output = wf::get_core().output_layout->get_output_coords_at(origin, origin);
+        priv->motion_output = output ?: current_output;
+        priv->motion_output->render->add_animation(&priv->on_motion_frame);
+    }
+}
+
+void core_drag_t::flush_pending_motion()
+{
+    if (priv->motion_output)
+    {
+        priv->motion_output->render->rem_animation(&priv->on_motion_frame);
+        priv->motion_output = nullptr;
+    }
+
+    if (priv->pending_position)
+    {
+        auto to = *priv->pending_position;
+        priv->pending_position.reset();
+        apply_motion(to);
+    }
+}
+
+void core_drag_t::apply_motion(wf::point_t to)
 {
     if (priv->view_held_in_place)
     {
@@ -421,13 +492,9 @@ void core_drag_t::handle_motion(wf::point_t to)
         }
     }
 
-    // Update wobbly independently of the grab position.
-    // This is because while held in place, wobbly is anchored to its edges
-    // so we can still move the grabbed point without moving the view.
-    for (auto& v : priv->all_views)
+    if (!priv->view_held_in_place)
     {
-        move_wobbly(v.view, to.x, to.y);
-        if (!priv->view_held_in_place)
+        for (auto& v : priv->all_views)
         {
             v.view->get_transformed_node()->begin_transform_update();
             v.transformer->grab_position = to;
@@ -439,6 +506,8 @@ void core_drag_t::handle_motion(wf::point_t to)
 
     drag_motion_signal data;
     data.current_position = to;
+    data.raw_positions    = std::move(priv->raw_positions);
+    priv->raw_positions.clear();
     emit(&data);
 }
 
@@ -449,6 +518,8 @@ double core_drag_t::distance_to_grab_origin(wf::point_t to) const
 
 void core_drag_t::handle_input_released()
 {
+    // Drop the views where the input was released, not where they were last shown.
+    flush_pending_motion();
     if (!view || priv->all_views.empty())
     {
         this->tentative_grab_position = {};
@@ -501,6 +572,7 @@ void core_drag_t::handle_input_released()
     wf::get_core().default_wm->set_view_grabbed(view, false);
     view = nullptr;
     priv->all_views.clear();
+    priv->raw_positions.clear();
     if (current_output)
     {
         current_output->render->rem_effect(&priv->on_pre_frame);
@@ -46,11 +46,17 @@ struct drag_focus_output_signal
 };
 
 /**
- * Emitted on core_drag_t when input motion is triggered.
+ * Emitted on core_drag_t when the dragged views are moved, at most once per frame.
  */
 struct drag_motion_signal
 {
     wf::point_t current_position;
+
+    /**
+     * All input positions passed to handle_motion() since the last drag motion signal, in the order they were
+     * received. The last one is current_position.
+     */
+    std::vector<wf::point_t> raw_positions;
 };
 
 /**
@@ -195,6 +201,13 @@ class core_drag_t : public signal::provider_t
     void start_drag(wayfire_toplevel_view grab_view, wf::pointf_t relative, const drag_options_t& options);
     void start_drag(wayfire_toplevel_view view, const drag_options_t& options);
 
+    /**
+     * Handle input motion during the drag.
+     *
+     * Wobbly receives every position immediately. The dragged views however are moved only once per frame of
+     * the output under the input (except for the first motion after start_drag()), so that fast input does
+     * not cause repeated damage and drag_motion_signal emissions within a frame.
+     */
     void handle_motion(wf::point_t to);
 
     double distance_to_grab_origin(wf::point_t to) const;
@@ -216,6 +229,12 @@ class core_drag_t : public signal::provider_t
 
     void update_current_output(wf::point_t grab);
     void update_current_output(wf::output_t *output);
+
+    /** Move the dragged views to the given position. */
+    void apply_motion(wf::point_t to);
+
+    /** Apply motion which is waiting for the next frame, if any. */
+    void flush_pending_motion();
 };
 
 /**
@@ -102,7 +102,22 @@ class wayfire_cube : public wf::per_output_plugin_instance_t, public wf::pointer
                 {
                     const float scale = self->cube->output->handle->scale;
                     auto bbox = self->workspaces[i]->get_bounding_box();
-                    framebuffers[i].allocate(wf::dimensions(bbox), scale);
+                    auto result = framebuffers[i].allocate(wf::dimensions(bbox), scale);
+                    if (result == wf::buffer_reallocation_result_t::FAILED)
+                    {
+                        continue;
+                    } else if (result == wf::buffer_reallocation_result_t::REALLOCATED)
+                    {
+                        // The old contents are gone, the whole face has to be repainted.
+                        ws_damage[i] |= bbox;
+                    }
+
+                    if (ws_damage[i].empty())
+                    {
+                        // Nothing changed on this workspace since the last frame, so we keep the face
+                        // as it is and only redraw the cube geometry with it.
+                        continue;
+                    }
 
                     wf::render_target_t target{framebuffers[i]};
                     target.geometry = self->workspaces[i]->get_bounding_box();
@@ -73,6 +73,12 @@ class crossfade_node_t : public scene::view_2d_transformer_t
         return "crossfade";
     }
 
+    std::optional<wf::texture_t> to_texture() const override
+    {
+        // The overlay with the old contents is not part of the children's texture.
+        return {};
+    }
+
     float get_scale_x() const override
     {
         auto current_geometry = view->get_geometry();
@@ -195,7 +201,7 @@ class grid_animation_t : public wf::custom_data_t
         this->type   = type;
         this->animation = wf::geometry_animation_t{duration};
 
-        output->render->add_effect(&pre_hook, wf::OUTPUT_EFFECT_PRE);
+        output->render->add_animation(&animation_hook);
         output->connect(&on_disappear);
     }
 
@@ -262,7 +268,7 @@ class grid_animation_t : public wf::custom_data_t
     ~grid_animation_t()
     {
         view->get_transformed_node()->rem_transformer<crossfade_node_t>();
-        output->render->rem_effect(&pre_hook);
+        output->render->rem_animation(&animation_hook);
     }
 
     grid_animation_t(const grid_animation_t &) = delete;
@@ -271,11 +277,12 @@ class grid_animation_t : public wf::custom_data_t
     grid_animation_t& operator =(grid_animation_t&&) = delete;
 
   protected:
-    wf::effect_hook_t pre_hook = [=] ()
+    wf::animation_hook_t animation_hook = [=] (int64_t)
     {
         if (!animation.running())
         {
-            return destroy();
+            destroy();
+            return false;
         }
 
         if (view->get_geometry() != original)
@@ -289,6 +296,7 @@ class grid_animation_t : public wf::custom_data_t
         tr->displayed_geometry = animation;
         tr->overlay_alpha = animation.progress();
         view->get_transformed_node()->end_transform_update();
+        return true;
     };
 
     void destroy()
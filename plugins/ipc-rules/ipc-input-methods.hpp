@@ -4,6 +4,9 @@
 #include "wayfire/core.hpp"
 #include "wayfire/debug.hpp"
 #include <wayfire/input-device.hpp>
+#include <wayfire/seat.hpp>
+#include <wayfire/bindings-repository.hpp>
+#include <wayfire/option-wrapper.hpp>
 #include <wayfire/nonstd/wlroots-full.hpp>
 
 namespace wf
@@ -15,12 +18,18 @@ class ipc_rules_input_methods_t
     {
         method_repository->register_method("input/list-devices", list_input_devices);
         method_repository->register_method("input/configure-device", configure_input_device);
+        method_repository->register_method("input/get-pointer-stats", get_pointer_stats);
+        method_repository->register_method("input/get-binding-stats", get_binding_stats);
+        method_repository->register_method("input/get-latency-stats", get_latency_stats);
     }
 
     void fini_input_methods(ipc::method_repository_t *method_repository)
     {
         method_repository->unregister_method("input/list-devices");
         method_repository->unregister_method("input/configure-device");
+        method_repository->unregister_method("input/get-pointer-stats");
+        method_repository->unregister_method("input/get-binding-stats");
+        method_repository->unregister_method("input/get-latency-stats");
     }
 
     static std::string wlr_input_device_type_to_string(wlr_input_device_type type)
@@ -94,5 +103,74 @@ class ipc_rules_input_methods_t
 
         return wf::ipc::json_error("Unknown input device!");
     };
+
+    wf::ipc::method_callback get_pointer_stats = [&] (const wf::json_t& data)
+    {
+        auto reset = wf::ipc::json_get_optional_bool(data, "reset");
+        auto& seat = wf::get_core().seat;
+        auto stats = seat->get_pointer_motion_stats();
+
+        auto response = wf::ipc::json_ok();
+        response["coalescing"]        = (bool)wf::option_wrapper_t<bool>{"input/coalesce_pointer_motion"};
+        response["motion-events"]     = stats.events;
+        response["motion-dispatched"] = stats.dispatched;
+        response["motion-coalesced"]  = stats.coalesced;
+        if (reset.value_or(false))
+        {
+            seat->reset_pointer_motion_stats();
+        }
+
+        return response;
+    };
+
+    wf::ipc::method_callback get_binding_stats = [&] (const wf::json_t& data)
+    {
+        auto reset = wf::ipc::json_get_optional_bool(data, "reset");
+        auto& bindings = wf::get_core().bindings;
+        auto stats     = bindings->get_lookup_stats();
+
+        auto response = wf::ipc::json_ok();
+        response["lookups"]     = stats.lookups;
+        response["index-hits"]  = stats.index_hits;
+        response["comparisons"] = stats.comparisons;
+        if (reset.value_or(false))
+        {
+            bindings->reset_lookup_stats();
+        }
+
+        return response;
+    };
+
+    static wf::json_t percentiles_to_json(const wf::latency_percentiles_t& percentiles)
+    {
+        wf::json_t result;
+        result["count"]  = percentiles.count;
+        result["p50-us"] = percentiles.p50_us;
+        result["p90-us"] = percentiles.p90_us;
+        result["p99-us"] = percentiles.p99_us;
+        result["max-us"] = percentiles.max_us;
+        return result;
+    }
+
+    wf::ipc::method_callback get_latency_stats = [&] (const wf::json_t& data)
+    {
+        auto reset = wf::ipc::json_get_optional_bool(data, "reset");
+        auto& seat = wf::get_core().seat;
+        auto stats = seat->get_input_latency_stats();
+
+        auto response = wf::ipc::json_ok();
+        response["tracing"]  = (bool)wf::option_wrapper_t<bool>{"input/trace_latency"};
+        response["handling"] = percentiles_to_json(stats.handling);
+        response["client"]   = percentiles_to_json(stats.client);
+        response["present"]  = percentiles_to_json(stats.present);
+        response["total"]    = percentiles_to_json(stats.total);
+        response["dropped"]  = stats.dropped;
+        if (reset.value_or(false))
+        {
+            seat->reset_input_latency_stats();
+        }
+
+        return response;
+    };
 };
 }
@@ -205,6 +205,11 @@ static inline wf::json_t view_to_json(wayfire_view view)
     description["focusable"] = view->is_focusable();
     description["type"] = get_view_type(view);
 
+    auto frame_rate_cap = view->get_data<wf::scene::frame_rate_cap_t>();
+    description["max-fps"]                = frame_rate_cap ? frame_rate_cap->max_fps : 0;
+    description["max-fps-unfocused-only"] = frame_rate_cap ? frame_rate_cap->only_unfocused : false;
+    description["suppressed-frames"]      = frame_rate_cap ? frame_rate_cap->suppressed : 0;
+
     return description;
 }
 
@@ -37,6 +37,7 @@ class ipc_rules_t : public wf::plugin_interface_t,
         method_repository->register_method("window-rules/get-focused-view", get_focused_view);
         method_repository->register_method("window-rules/get-focused-output", get_focused_output);
         method_repository->register_method("window-rules/close-view", close_view);
+        method_repository->register_method("window-rules/set-frame-rate-cap", set_frame_rate_cap);
 
         init_input_methods(method_repository.get());
         init_utility_methods(method_repository.get());
@@ -57,6 +58,7 @@ class ipc_rules_t : public wf::plugin_interface_t,
         method_repository->unregister_method("window-rules/get-focused-output");
         method_repository->unregister_method("window-rules/get-cursor-position");
         method_repository->unregister_method("window-rules/close-view");
+        method_repository->unregister_method("window-rules/set-frame-rate-cap");
 
         fini_input_methods(method_repository.get());
         fini_utility_methods(method_repository.get());
@@ -66,7 +68,7 @@ class ipc_rules_t : public wf::plugin_interface_t,
     wf::ipc::method_callback list_views = [=] (wf::json_t)
     {
         wf::json_t response = wf::json_t::array();
-        for (auto& view : wf::get_core().get_all_views())
+        for (auto& view : wf::get_core().view_registry->get_all_views())
         {
             wf::json_t v = view_to_json(view);
             response.append(v);
@@ -151,6 +153,25 @@ class ipc_rules_t : public wf::plugin_interface_t,
         return wf::ipc::json_error("no such view");
     };
 
+    wf::ipc::method_callback set_frame_rate_cap = [=] (wf::json_t data)
+    {
+        auto id = wf::ipc::json_get_uint64(data, "id");
+        auto max_fps = wf::ipc::json_get_int64(data, "max_fps");
+        auto unfocused_only = wf::ipc::json_get_optional_bool(data, "unfocused_only");
+        if ((max_fps < 0) || (max_fps > 1000))
+        {
+            return wf::ipc::json_error("max_fps must be between 0 (no cap) and 1000");
+        }
+
+        if (auto view = wf::ipc::find_view_by_id(id))
+        {
+            wf::scene::set_frame_rate_cap(view, max_fps, unfocused_only.value_or(false));
+            return wf::ipc::json_ok();
+        }
+
+        return wf::ipc::json_error("no such view");
+    };
+
     wf::ipc::method_callback list_outputs = [=] (wf::json_t)
     {
         wf::json_t response = wf::json_t::array();
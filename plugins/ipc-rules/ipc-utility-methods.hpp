@@ -4,6 +4,8 @@
 #include "wayfire/plugins/ipc/ipc-method-repository.hpp"
 #include "wayfire/debug.hpp"
 #include "wayfire/signal-definitions.hpp"
+#include "wayfire/view-transform.hpp"
+#include "wayfire/txn/transaction-manager.hpp"
 #include <set>
 #include <wayfire/plugin.hpp>
 #include <wayfire/nonstd/wlroots-full.hpp>
@@ -34,6 +36,8 @@ class ipc_rules_utility_methods_t
         method_repository->register_method("wayfire/set-config-options", set_config_options);
         method_repository->register_method("wayfire/get-keyboard-state", get_kb_state);
         method_repository->register_method("wayfire/set-keyboard-state", set_kb_state);
+        method_repository->register_method("wayfire/get-render-stats", get_render_stats);
+        method_repository->register_method("wayfire/get-transaction-stats", get_transaction_stats);
     }
 
     void fini_utility_methods(ipc::method_repository_t *method_repository)
@@ -45,6 +49,8 @@ class ipc_rules_utility_methods_t
         method_repository->unregister_method("wayfire/set-config-option");
         method_repository->unregister_method("wayfire/get-keyboard-state");
         method_repository->unregister_method("wayfire/set-keyboard-state");
+        method_repository->unregister_method("wayfire/get-render-stats");
+        method_repository->unregister_method("wayfire/get-transaction-stats");
     }
 
     wf::ipc::method_callback get_wayfire_configuration_info = [=] (wf::json_t)
@@ -340,5 +346,69 @@ class ipc_rules_utility_methods_t
             keyboard->modifiers.latched, keyboard->modifiers.locked, index);
         return wf::ipc::json_ok();
     };
+
+    wf::ipc::method_callback get_render_stats = [=] (const wf::json_t& data) -> json_t
+    {
+        const auto& tr_stats = wf::scene::get_transformer_texture_stats();
+
+        wf::json_t transformers;
+        transformers["zero-copy"]  = tr_stats.zero_copy;
+        transformers["aux-buffer"] = tr_stats.aux_buffer;
+        transformers["aux-buffer-reused"] = tr_stats.aux_buffer_reused;
+
+        auto response = wf::ipc::json_ok();
+        response["transformers"] = transformers;
+        return response;
+    };
+
+    static wf::json_t histogram_to_json(const wf::txn::latency_histogram_t& histogram)
+    {
+        wf::json_t buckets = wf::json_t::array();
+        for (int i = 0; i < wf::txn::latency_histogram_t::NUM_BUCKETS; i++)
+        {
+            wf::json_t bucket;
+            if (i < wf::txn::latency_histogram_t::NUM_BUCKETS - 1)
+            {
+                bucket["below-ms"] = 1 << i;
+            }
+
+            bucket["count"] = histogram.buckets[i];
+            buckets.append(bucket);
+        }
+
+        wf::json_t result;
+        result["count"]   = histogram.count;
+        result["mean-us"] = histogram.count ? (histogram.total_us / (int64_t)histogram.count) : 0;
+        result["max-us"]  = histogram.max_us;
+        result["buckets"] = buckets;
+        return result;
+    }
+
+    wf::ipc::method_callback get_transaction_stats = [=] (const wf::json_t& data) -> json_t
+    {
+        auto reset = wf::ipc::json_get_optional_bool(data, "reset");
+        auto& tx_manager = wf::get_core().tx_manager;
+
+        wf::json_t clients = wf::json_t::array();
+        for (auto& stats : tx_manager->get_client_stats())
+        {
+            wf::json_t client;
+            client["app-id"]   = stats.client.app_id;
+            client["pid"]      = stats.client.pid;
+            client["ready"]    = histogram_to_json(stats.ready);
+            client["apply"]    = histogram_to_json(stats.apply);
+            client["timeouts"] = stats.timeouts;
+            clients.append(client);
+        }
+
+        if (reset.value_or(false))
+        {
+            tx_manager->reset_client_stats();
+        }
+
+        auto response = wf::ipc::json_ok();
+        response["clients"] = clients;
+        return response;
+    };
 };
 }
@@ -4,6 +4,7 @@
 #include "wayfire/geometry.hpp"
 #include <wayfire/output.hpp>
 #include <wayfire/view.hpp>
+#include <wayfire/view-registry.hpp>
 #include <wayfire/workspace-set.hpp>
 #include <wayfire/core.hpp>
 #include <wayfire/output-layout.hpp>
@@ -57,15 +58,7 @@ WFJSON_GETTER_FUNCTION(bool, bool);
 
 inline wayfire_view find_view_by_id(uint32_t id)
 {
-    for (auto view : wf::get_core().get_all_views())
-    {
-        if (view->get_id() == id)
-        {
-            return view;
-        }
-    }
-
-    return nullptr;
+    return wf::get_core().view_registry->find_view_by_id(id);
 }
 
 inline wf::output_t *find_output_by_id(int32_t id)
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <wayfire/view-transform.hpp>
+#include <wayfire/render.hpp>
+
+/**
+ * The 2D transformer used by scale.
+ *
+ * With many views in scale, sampling each view at full resolution and minifying it to a small thumbnail
+ * costs a lot of bandwidth and aliases. Instead, the transformer can keep a chain of downscaled snapshots
+ * of the view (similar to mipmaps): the first level is rendered from the view at half the output scale, and
+ * each following level is a 2x box-filtered copy of the previous one. The view is then drawn from the
+ * smallest level which still has at least the resolution of the thumbnail.
+ *
+ * Only the damaged parts of the levels are updated, so an idle view costs one small textured quad per
+ * frame, and a damaged view costs in proportion to the damaged area.
+ *
+ * Scale does not rotate views, so rotation is not supported when snapshots are enabled.
+ */
+class scale_snapshot_transformer_t : public wf::scene::view_2d_transformer_t
+{
+  public:
+    // Levels beyond this are not worth the extra buffers.
+    static constexpr int MAX_SNAPSHOT_LEVEL = 5;
+
+    scale_snapshot_transformer_t(wayfire_view view, bool use_snapshots) :
+        view_2d_transformer_t(view), use_snapshots(use_snapshots)
+    {}
+
+    // Whether downscaled snapshots are used. If false, the transformer works exactly like a plain
+    // view_2d_transformer_t and the view is rendered live at full resolution.
+    const bool use_snapshots;
+
+    /**
+     * Get the snapshot level to use for the current scale of the transformer.
+     * Level 0 means full resolution, level N means 2^-N of the output resolution.
+     */
+    int get_snapshot_level() const
+    {
+        const float displayed = std::max(get_scale_x(), get_scale_y());
+        if (!use_snapshots || (displayed <= 0))
+        {
+            return 0;
+        }
+
+        const int level = std::floor(std::log2(1.0 / displayed));
+        return std::clamp(level, 0, MAX_SNAPSHOT_LEVEL);
+    }
+
+    std::optional<wf::texture_t> to_texture() const override
+    {
+        if (get_snapshot_level() > 0)
+        {
+            return {};
+        }
+
+        return view_2d_transformer_t::to_texture();
+    }
+
+    /**
+     * Update the snapshot chain up to the given level and return the texture of that level.
+     *
+     * @param level The snapshot level, at least 1.
+     * @param output_scale The scale of the output the view is rendered on.
+     * @param children The render instances of the transformer's children.
+     */
+    wf::texture_t get_snapshot(int level, float output_scale,
+        std::vector<wf::scene::render_instance_uptr>& children)
+    {
+        // The snapshot chain replaces the full-size aux buffer.
+        release_buffers();
+
+        auto bbox = get_children_bounding_box();
+        snapshots.resize(level);
+
+        float level_scale = output_scale / 2;
+        wf::region_t damage = cached_damage & bbox;
+        cached_damage.clear();
+        auto result = snapshots[0].allocate(wf::dimensions(bbox), level_scale);
+        if (result != wf::buffer_reallocation_result_t::SAME)
+        {
+            damage = bbox;
+        }
+
+        if (!damage.empty())
+        {
+            wf::render_target_t target{snapshots[0]};
+            target.geometry = bbox;
+            target.scale    = level_scale;
+
+            wf::render_pass_params_t params;
+            params.instances = &children;
+            params.target    = target;
+            params.damage    = damage;
+            params.background_color = {0.0f, 0.0f, 0.0f, 0.0f};
+            params.flags = wf::RPASS_CLEAR_BACKGROUND;
+            wf::render_pass_t::run(params);
+        }
+
+        for (int i = 1; i < level; i++)
+        {
+            level_scale /= 2;
+            result = snapshots[i].allocate(wf::dimensions(bbox), level_scale);
+            if (result != wf::buffer_reallocation_result_t::SAME)
+            {
+                damage = bbox;
+            } else if (!damage.empty())
+            {
+                // Damaged boxes rarely align with the pixels of the smaller level, so extend them to whole
+                // pixels of it.
+                damage.expand_edges(std::ceil(1.0 / level_scale));
+                damage &= bbox;
+            }
+
+            if (!damage.empty())
+            {
+                downsample(snapshots[i - 1], snapshots[i], bbox, level_scale, damage);
+            }
+        }
+
+        wf::texture_t tex{snapshots[level - 1].get_texture()};
+        tex.filter_mode = WLR_SCALE_FILTER_BILINEAR;
+        return tex;
+    }
+
+    void release_snapshots()
+    {
+        snapshots.clear();
+    }
+
+    void gen_render_instances(std::vector<wf::scene::render_instance_uptr>& instances,
+        wf::scene::damage_callback push_damage, wf::output_t *shown_on) override;
+
+  private:
+    std::vector<wf::auxilliary_buffer_t> snapshots;
+
+    // Copy the damaged parts of @source to @dest at half the resolution. Bilinear sampling at exactly half
+    // the size averages each 2x2 block of the source, so this works as a box filter.
+    static void downsample(wf::auxilliary_buffer_t& source, wf::auxilliary_buffer_t& dest,
+        wf::geometry_t bbox, float dest_scale, const wf::region_t& damage)
+    {
+        wf::render_target_t target{dest};
+        target.geometry = bbox;
+        target.scale    = dest_scale;
+
+        wf::render_pass_params_t params;
+        params.target = target;
+        params.damage = damage;
+        params.background_color = {0.0f, 0.0f, 0.0f, 0.0f};
+        params.flags = wf::RPASS_CLEAR_BACKGROUND;
+
+        wf::render_pass_t pass{params};
+        pass.run_partial();
+
+        wf::texture_t tex{source.get_texture()};
+        tex.filter_mode = WLR_SCALE_FILTER_BILINEAR;
+        pass.add_texture(tex, target, bbox, damage);
+        pass.submit();
+    }
+};
+
+class scale_snapshot_render_instance_t :
+    public wf::scene::transformer_render_instance_t<scale_snapshot_transformer_t>
+{
+  public:
+    using transformer_render_instance_t::transformer_render_instance_t;
+
+    void transform_damage_region(wf::region_t& damage) override
+    {
+        auto copy = damage;
+        damage.clear();
+        for (auto& box : copy)
+        {
+            damage |= wf::get_bbox_for_node(self, wlr_box_from_pixman_box(box));
+        }
+    }
+
+    void render(const wf::scene::render_instruction_t& data) override
+    {
+        const int level = self->get_snapshot_level();
+
+        wf::texture_t tex;
+        if (level > 0)
+        {
+            tex = self->get_snapshot(level, data.target.scale, children);
+        } else
+        {
+            self->release_snapshots();
+            tex = get_texture(data.target.scale);
+            tex.filter_mode = WLR_SCALE_FILTER_BILINEAR;
+        }
+
+        data.pass->add_texture(tex, data.target, self->get_bounding_box(), data.damage, self->get_alpha());
+    }
+};
+
+inline void scale_snapshot_transformer_t::gen_render_instances(
+    std::vector<wf::scene::render_instance_uptr>& instances,
+    wf::scene::damage_callback push_damage, wf::output_t *shown_on)
+{
+    if (!use_snapshots)
+    {
+        view_2d_transformer_t::gen_render_instances(instances, push_damage, shown_on);
+        return;
+    }
+
+    auto uptr = std::make_unique<scale_snapshot_render_instance_t>(this, push_damage, shown_on);
+    if (uptr->has_instances())
+    {
+        instances.push_back(std::move(uptr));
+    }
+}
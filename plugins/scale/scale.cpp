@@ -27,6 +27,7 @@
 #include "wayfire/plugins/ipc/ipc-activator.hpp"
 #include "scale.hpp"
 #include "scale-title-overlay.hpp"
+#include "scale-snapshot.hpp"
 #include "wayfire/core.hpp"
 #include "wayfire/debug.hpp"
 #include "wayfire/plugin.hpp"
@@ -116,6 +117,7 @@ class wayfire_scale : public wf::per_output_plugin_instance_t,
     wf::option_wrapper_t<bool> allow_scale_zoom{"scale/allow_zoom"};
     wf::option_wrapper_t<bool> include_minimized{"scale/include_minimized"};
     wf::option_wrapper_t<bool> close_on_new_view{"scale/close_on_new_view"};
+    wf::option_wrapper_t<bool> downscaled_snapshots{"scale/downscaled_snapshots"};
 
     /* maximum scale -- 1.0 means we will not "zoom in" on a view */
     const double max_scale_factor = 1.0;
@@ -203,7 +205,7 @@ class wayfire_scale : public wf::per_output_plugin_instance_t,
             return false;
         }
 
-        auto tr = std::make_shared<wf::scene::view_2d_transformer_t>(view);
+        auto tr = std::make_shared<scale_snapshot_transformer_t>(view, downscaled_snapshots);
         scale_data[view].transformer = tr;
         view->get_transformed_node()->add_transformer(tr, wf::TRANSFORMER_2D + 1,
             SCALE_TRANSFORMER);
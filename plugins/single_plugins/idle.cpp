@@ -10,6 +10,7 @@
 #include "wayfire/toplevel-view.hpp"
 #include "../cube/cube-control-signal.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <optional>
 #include <wayfire/util/duration.hpp>
@@ -132,7 +133,7 @@ class wayfire_idle_plugin : public wf::per_output_plugin_instance_t
     cube_screensaver_state state = CUBE_SCREENSAVER_DISABLED;
     bool hook_set = false;
     bool output_inhibited = false;
-    uint32_t last_time;
+    int64_t last_time;
     wf::wl_timer<false> timeout_screensaver;
     wf::signal::connection_t<wf::seat_activity_signal> on_seat_activity;
     wf::shared_data::ref_ptr_t<wayfire_idle> global_idle;
@@ -281,7 +282,7 @@ class wayfire_idle_plugin : public wf::per_output_plugin_instance_t
 
         if (hook_set)
         {
-            output->render->rem_effect(&screensaver_frame);
+            output->render->rem_animation(&screensaver_frame);
             hook_set = false;
         }
 
@@ -315,7 +316,7 @@ class wayfire_idle_plugin : public wf::per_output_plugin_instance_t
         output->emit(&data);
         if (hook_set)
         {
-            output->render->rem_effect(&screensaver_frame);
+            output->render->rem_animation(&screensaver_frame);
             hook_set = false;
         }
 
@@ -327,19 +328,18 @@ class wayfire_idle_plugin : public wf::per_output_plugin_instance_t
         state = CUBE_SCREENSAVER_DISABLED;
     }
 
-    wf::effect_hook_t screensaver_frame = [=] ()
+    wf::animation_hook_t screensaver_frame = [=] (int64_t frame_time)
     {
         cube_control_signal data;
-        uint32_t current = wf::get_current_time();
-        uint32_t elapsed = current - last_time;
+        int64_t elapsed = std::max<int64_t>(frame_time - last_time, 0);
 
-        last_time = current;
+        last_time = frame_time;
 
         if ((state == CUBE_SCREENSAVER_STOPPING) && !screensaver_animation.running())
         {
             screensaver_terminate();
 
-            return;
+            return false;
         }
 
         if (state == CUBE_SCREENSAVER_STOPPING)
@@ -366,13 +366,15 @@ class wayfire_idle_plugin : public wf::per_output_plugin_instance_t
         {
             screensaver_terminate();
 
-            return;
+            return false;
         }
 
         if (state == CUBE_SCREENSAVER_STOPPING)
         {
             wf::get_core().seat->notify_activity();
         }
+
+        return true;
     };
 
     void start_screensaver()
@@ -389,8 +391,7 @@ class wayfire_idle_plugin : public wf::per_output_plugin_instance_t
         {
             if (!hook_set)
             {
-                output->render->add_effect(
-                    &screensaver_frame, wf::OUTPUT_EFFECT_PRE);
+                output->render->add_animation(&screensaver_frame);
                 hook_set = true;
             }
         } else if (state == CUBE_SCREENSAVER_DISABLED)
@@ -406,6 +407,7 @@ class wayfire_idle_plugin : public wf::per_output_plugin_instance_t
         screensaver_animation.zoom.set(CUBE_ZOOM_BASE, cube_max_zoom);
         screensaver_animation.ease.set(0.0, 1.0);
         screensaver_animation.start();
+        // The last frame time of the output is stale after the idle timeout, frame times use the same clock.
         last_time = wf::get_current_time();
     }
 
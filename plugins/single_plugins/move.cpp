@@ -80,6 +80,17 @@ class wayfire_move : public wf::per_output_plugin_instance_t,
         }
     };
 
+    wf::signal::connection_t<wf::move_drag::drag_motion_signal> on_drag_motion =
+        [=] (wf::move_drag::drag_motion_signal *ev)
+    {
+        // The drag motion signal is emitted once per frame, so this avoids recalculating the slot for every
+        // input event.
+        if ((drag_helper->current_output == output) && output->is_plugin_active(grab_interface.name))
+        {
+            update_slot(calc_slot(ev->current_position - wf::origin(output->get_layout_geometry())));
+        }
+    };
+
     wf::signal::connection_t<wf::move_drag::snap_off_signal> on_drag_snap_off =
         [=] (wf::move_drag::snap_off_signal *ev)
     {
@@ -192,6 +203,7 @@ class wayfire_move : public wf::per_output_plugin_instance_t,
         output->connect(&move_request);
 
         drag_helper->connect(&on_drag_output_focus);
+        drag_helper->connect(&on_drag_motion);
         drag_helper->connect(&on_drag_snap_off);
         drag_helper->connect(&on_drag_done);
     }
@@ -582,7 +594,6 @@ class wayfire_move : public wf::per_output_plugin_instance_t,
     void handle_input_motion()
     {
         drag_helper->handle_motion(get_global_input_coords());
-        update_slot(calc_slot(get_input_coords()));
     }
 
     void fini() override
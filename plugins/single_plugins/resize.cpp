@@ -2,6 +2,7 @@
 #include "wayfire/plugins/common/input-grab.hpp"
 #include "wayfire/scene-input.hpp"
 #include "wayfire/txn/transaction-manager.hpp"
+#include "wayfire/txn/throttled-scheduler.hpp"
 #include <wayfire/toplevel.hpp>
 #include <cmath>
 #include <wayfire/per-output-plugin.hpp>
@@ -68,6 +69,10 @@ class wayfire_resize : public wf::per_output_plugin_instance_t, public wf::point
     wf::option_wrapper_t<wf::buttonbinding_t> button_preserve_aspect{
         "resize/activate_preserve_aspect"};
     std::unique_ptr<wf::input_grab_t> input_grab;
+
+    // Keeps at most one configure in flight, so that slow clients are not flooded while resizing.
+    std::unique_ptr<wf::txn::throttled_scheduler_t> scheduler;
+
     wf::plugin_activation_data_t grab_interface = {
         .name = "resize",
         .capabilities = wf::CAPABILITY_GRAB_INPUT | wf::CAPABILITY_MANAGE_DESKTOP,
@@ -232,6 +237,8 @@ class wayfire_resize : public wf::per_output_plugin_instance_t, public wf::point
         }
 
         this->view = view;
+        scheduler  = std::make_unique<wf::txn::throttled_scheduler_t>(
+            *wf::get_core().tx_manager, view->toplevel());
 
         auto og = view->get_bounding_box();
         int anchor_x = og.x;
@@ -265,6 +272,12 @@ class wayfire_resize : public wf::per_output_plugin_instance_t, public wf::point
 
         if (view)
         {
+            // Send the final size without waiting for the client to catch up.
+            if (scheduler)
+            {
+                scheduler->flush();
+            }
+
             end_wobbly(view);
 
             wf::view_change_workspace_signal workspace_may_changed;
@@ -273,6 +286,8 @@ class wayfire_resize : public wf::per_output_plugin_instance_t, public wf::point
             workspace_may_changed.old_workspace_valid = false;
             output->emit(&workspace_may_changed);
         }
+
+        scheduler.reset();
     }
 
     // Convert resize edges to gravity
@@ -446,7 +461,7 @@ class wayfire_resize : public wf::per_output_plugin_instance_t, public wf::point
         {
             view->toplevel()->pending().gravity  = calculate_gravity();
             view->toplevel()->pending().geometry = desired;
-            wf::get_core().tx_manager->schedule_object(view->toplevel());
+            scheduler->schedule();
         }
     }
 
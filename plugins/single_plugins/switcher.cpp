@@ -27,6 +27,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <algorithm>
+#include <map>
 #include <set>
 
 constexpr const char *switcher_transformer = "switcher-3d";
@@ -186,6 +187,22 @@ class WayfireSwitcher : public wf::per_output_plugin_instance_t, public wf::keyb
     };
 
     std::shared_ptr<switcher_render_node_t> render_node;
+
+    // Render instances of the views shown by the switcher. They are kept for the whole duration of the
+    // switcher, so that the view transformers can reuse the contents of views which did not change since
+    // the last frame, instead of repainting every view from scratch on each frame.
+    std::map<wayfire_view, std::vector<wf::scene::render_instance_uptr>> view_instances;
+
+    wf::signal::connection_t<wf::scene::root_node_update_signal> on_root_node_updated =
+        [=] (wf::scene::root_node_update_signal *ev)
+    {
+        if ((ev->flags & (wf::scene::update_flag::CHILDREN_LIST | wf::scene::update_flag::ENABLED)) &&
+            !(ev->flags & wf::scene::update_flag::MASKED))
+        {
+            view_instances.clear();
+        }
+    };
+
     wf::plugin_activation_data_t grab_interface = {
         .name = "switcher",
         .capabilities = wf::CAPABILITY_MANAGE_COMPOSITOR,
@@ -238,7 +255,10 @@ class WayfireSwitcher : public wf::per_output_plugin_instance_t, public wf::keyb
     wf::effect_hook_t pre_hook = [=] ()
     {
         dim_background(background_dim);
-        wf::scene::damage_node(render_node, render_node->get_bounding_box());
+        if (duration.running() || background_dim_duration.running())
+        {
+            damage_switcher();
+        }
 
         if (!duration.running())
         {
@@ -259,6 +279,14 @@ class WayfireSwitcher : public wf::per_output_plugin_instance_t, public wf::keyb
         }
     };
 
+    void damage_switcher()
+    {
+        if (render_node)
+        {
+            wf::scene::damage_node(render_node, render_node->get_bounding_box());
+        }
+    }
+
     void handle_view_removed(wayfire_toplevel_view view)
     {
         // not running at all, don't care
@@ -267,6 +295,8 @@ class WayfireSwitcher : public wf::per_output_plugin_instance_t, public wf::keyb
             return;
         }
 
+        view_instances.erase(view);
+
         bool need_action = false;
         for (auto& sv : views)
         {
@@ -287,6 +317,8 @@ class WayfireSwitcher : public wf::per_output_plugin_instance_t, public wf::keyb
             cleanup_views([=] (SwitcherView& sv)
             { return sv.view == view; });
         }
+
+        damage_switcher();
     }
 
     bool handle_switch_request(int dir)
@@ -320,6 +352,7 @@ class WayfireSwitcher : public wf::per_output_plugin_instance_t, public wf::keyb
             next_view(dir);
         }
 
+        damage_switcher();
         return true;
     }
 
@@ -329,6 +362,7 @@ class WayfireSwitcher : public wf::per_output_plugin_instance_t, public wf::keyb
         cleanup_expired();
         dearrange();
         input_grab->ungrab_input();
+        damage_switcher();
     }
 
     /* Sets up basic hooks needed while switcher works and/or displays animations.
@@ -344,6 +378,7 @@ class WayfireSwitcher : public wf::per_output_plugin_instance_t, public wf::keyb
 
         render_node = std::make_shared<switcher_render_node_t>(this);
         wf::scene::add_front(wf::get_core().scene(), render_node);
+        wf::get_core().scene()->connect(&on_root_node_updated);
         return true;
     }
 
@@ -353,6 +388,8 @@ class WayfireSwitcher : public wf::per_output_plugin_instance_t, public wf::keyb
         output->deactivate_plugin(&grab_interface);
 
         output->render->rem_effect(&pre_hook);
+        on_root_node_updated.disconnect();
+        view_instances.clear();
         wf::scene::remove_child(render_node);
         render_node = nullptr;
 
@@ -675,11 +712,21 @@ class WayfireSwitcher : public wf::per_output_plugin_instance_t, public wf::keyb
 
     void render_view_scene(wayfire_view view, const wf::render_target_t& buffer)
     {
-        std::vector<wf::scene::render_instance_uptr> instances;
-        view->get_transformed_node()->gen_render_instances(instances, [] (auto) {});
+        auto it = view_instances.find(view);
+        if (it == view_instances.end())
+        {
+            it = view_instances.emplace(view, std::vector<wf::scene::render_instance_uptr>{}).first;
+
+            // A view might be visible on more than one place, so we simply damage the whole output when
+            // its contents change.
+            view->get_transformed_node()->gen_render_instances(it->second, [=] (auto)
+            {
+                damage_switcher();
+            });
+        }
 
         wf::render_pass_params_t params;
-        params.instances = &instances;
+        params.instances = &it->second;
         params.damage    = view->get_transformed_node()->get_bounding_box();
         params.reference_output = this->output;
         params.target = buffer;
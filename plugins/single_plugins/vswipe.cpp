@@ -12,6 +12,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <wayfire/util/duration.hpp>
+#include <wayfire/input-resampler.hpp>
 
 #include <cmath>
 
@@ -70,6 +71,9 @@ class vswipe : public wf::per_output_plugin_instance_t
         wf::pointf_t delta_prev;
         wf::pointf_t delta_last;
 
+        /** The last resampled position, if resampling is enabled. */
+        wf::pointf_t resampled;
+
         int vx = 0;
         int vy = 0;
         int vw = 0;
@@ -92,6 +96,11 @@ class vswipe : public wf::per_output_plugin_instance_t
     wf::option_wrapper_t<double> delta_threshold{"vswipe/delta_threshold"};
     wf::option_wrapper_t<double> speed_factor{"vswipe/speed_factor"};
     wf::option_wrapper_t<double> speed_cap{"vswipe/speed_cap"};
+    wf::option_wrapper_t<bool> resample_input{"vswipe/resample_input"};
+    wf::option_wrapper_t<int> input_prediction{"vswipe/input_prediction"};
+
+    /** The swiped distance (as in smooth_delta's end values), resampled on each frame. */
+    wf::input_resampler_t resampler;
     std::unique_ptr<wf::input_grab_t> input_grab;
     wf::plugin_activation_data_t grab_interface = {
         .name = "vswipe",
@@ -143,6 +152,17 @@ class vswipe : public wf::per_output_plugin_instance_t
         {current_workspace.x + dx, current_workspace.y + dy};
         auto g1 = wall->get_workspace_rectangle(current_workspace);
         auto g2 = wall->get_workspace_rectangle(next_ws);
+        if (state.swiping && resample_input)
+        {
+            // Sample one event interval before the predicted presentation time of the frame, so that the
+            // position is usually interpolated between two real events. If that is still after the newest
+            // event, the resampler extrapolates at most input_prediction ms past it.
+            auto time = output->render->get_frame_time() - resampler.get_sample_interval();
+            state.resampled = resampler.sample_at(time);
+            wall->set_viewport(interpolate(g1, g2, -state.resampled.x, -state.resampled.y));
+            return;
+        }
+
         wall->set_viewport(interpolate(g1, g2, -smooth_delta.dx, -smooth_delta.dy));
     };
 
@@ -181,6 +201,11 @@ class vswipe : public wf::per_output_plugin_instance_t
         state.delta_last = {0, 0};
         state.delta_prev = {0, 0};
         state.delta_sum  = {0, 0};
+        state.resampled  = {0, 0};
+
+        resampler.reset();
+        resampler.set_max_prediction(input_prediction);
+        resampler.add_sample(wf::input_event_time_to_msec(ev->event->time_msec), {0, 0});
 
         // We switch the actual workspace before the finishing animation,
         // so the rendering of the animation cannot dynamically query current
@@ -297,8 +322,9 @@ class vswipe : public wf::per_output_plugin_instance_t
             current_delta_processed = vswipe_process_delta(delta / speed_factor, total_delta,
                 ws, ws_max, cap, enable_free_movement);
 
+            // Resampling takes care of smoothing the motion.
             double new_delta_end   = total_delta.end + current_delta_processed;
-            double new_delta_start = smooth_transition ? total_delta : new_delta_end;
+            double new_delta_start = (smooth_transition && !resample_input) ? total_delta : new_delta_end;
             total_delta.set(new_delta_start, new_delta_end);
         };
 
@@ -313,6 +339,8 @@ class vswipe : public wf::per_output_plugin_instance_t
         }
 
         state.delta_last = {ev->event->dx, ev->event->dy};
+        resampler.add_sample(wf::input_event_time_to_msec(ev->event->time_msec),
+            {smooth_delta.dx.end, smooth_delta.dy.end});
         smooth_delta.start();
     };
 
@@ -349,8 +377,17 @@ class vswipe : public wf::per_output_plugin_instance_t
             target_workspace.y -= target_delta.y;
         }
 
-        smooth_delta.dx.restart_with_end(target_delta.x);
-        smooth_delta.dy.restart_with_end(target_delta.y);
+        if (resample_input)
+        {
+            // Continue from the last position which was displayed.
+            smooth_delta.dx.set(state.resampled.x, target_delta.x);
+            smooth_delta.dy.set(state.resampled.y, target_delta.y);
+        } else
+        {
+            smooth_delta.dx.restart_with_end(target_delta.x);
+            smooth_delta.dy.restart_with_end(target_delta.y);
+        }
+
         smooth_delta.start();
         output->wset()->set_workspace(target_workspace);
         state.animating = true;
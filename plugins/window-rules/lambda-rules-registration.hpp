@@ -13,6 +13,7 @@
 #include "wayfire/rule/lambda_rule.hpp"
 #include "wayfire/util/log.hpp"
 #include "wayfire/view.hpp"
+#include "rule-set.hpp"
 
 class wayfire_window_rules_t;
 
@@ -92,6 +93,12 @@ struct lambda_rule_registration_t
      */
     std::shared_ptr<wf::lambda_rule_t> rule_instance;
 
+    /**
+     * @brief signal The signal the rule reacts to, filled in by the registration
+     * process. Empty if it could not be determined from the rule text.
+     */
+    std::string signal;
+
     // Friendship for window rules to be able to execute the rules.
     friend class ::wayfire_window_rules_t;
 
@@ -171,6 +178,7 @@ class lambda_rules_registrations_t : public custom_data_t
             return true; // Error, failed to parse rule.
         }
 
+        registration->signal = summarize_window_rule(registration->rule).signal;
         _registrations.emplace(key, registration);
 
         return false;
@@ -0,0 +1,290 @@
+#ifndef WINDOW_RULES_RULE_SET_HPP
+#define WINDOW_RULES_RULE_SET_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "wayfire/action/action_interface.hpp"
+#include "wayfire/condition/access_interface.hpp"
+#include "wayfire/rule/rule.hpp"
+#include "wayfire/variant.hpp"
+
+namespace wf
+{
+/**
+ * What can be told about a rule from its text without evaluating it.
+ */
+struct window_rule_summary_t
+{
+    /** The signal the rule reacts to, or empty if it could not be determined. */
+    std::string signal;
+
+    /**
+     * If set, the rule can only have an effect on views with this app-id, because its condition requires
+     * `app_id is "..."` and it has no else branch.
+     */
+    std::optional<std::string> app_id;
+};
+
+/**
+ * Scan the text of a window rule for its signal and for a required app-id.
+ *
+ * The analysis is conservative: conditions which contain anything other than conjunctions, parentheses,
+ * identifiers and double-quoted strings without escapes are never restricted to an app-id.
+ */
+inline window_rule_summary_t summarize_window_rule(const std::string& text)
+{
+    struct token_t
+    {
+        std::string text;
+        bool quoted;
+    };
+
+    std::vector<token_t> tokens;
+    bool can_restrict = true;
+    for (size_t i = 0; i < text.size();)
+    {
+        const char c = text[i];
+        if (std::isspace((unsigned char)c))
+        {
+            ++i;
+        } else if (c == '"')
+        {
+            std::string value;
+            for (++i; (i < text.size()) && (text[i] != '"'); ++i)
+            {
+                if ((text[i] == '\\') && (i + 1 < text.size()))
+                {
+                    // Escapes may be interpreted differently by the rule lexer.
+                    can_restrict = false;
+                    ++i;
+                }
+
+                value += text[i];
+            }
+
+            tokens.push_back({value, true});
+            ++i;
+        } else if (std::isalnum((unsigned char)c) || (c == '_') || (c == '-') || (c == '.'))
+        {
+            size_t start = i;
+            while ((i < text.size()) && (std::isalnum((unsigned char)text[i]) || (text[i] == '_') ||
+                                         (text[i] == '-') || (text[i] == '.')))
+            {
+                ++i;
+            }
+
+            tokens.push_back({text.substr(start, i - start), false});
+        } else
+        {
+            if ((c != '&') && (c != '(') && (c != ')'))
+            {
+                can_restrict = false;
+            }
+
+            tokens.push_back({std::string(1, c), false});
+            ++i;
+        }
+    }
+
+    window_rule_summary_t summary;
+    if ((tokens.size() < 2) || tokens[0].quoted || (tokens[0].text != "on") || tokens[1].quoted)
+    {
+        return summary;
+    }
+
+    summary.signal = tokens[1].text;
+
+    auto is_word = [&] (size_t i, const char *word)
+    {
+        return (i < tokens.size()) && !tokens[i].quoted && (tokens[i].text == word);
+    };
+
+    if ((tokens.size() < 3) || !is_word(2, "if"))
+    {
+        return summary;
+    }
+
+    std::optional<std::string> app_id;
+    size_t i = 3;
+    for (; (i < tokens.size()) && !is_word(i, "then"); ++i)
+    {
+        if (is_word(i, "or") || is_word(i, "not"))
+        {
+            can_restrict = false;
+        }
+
+        if (is_word(i, "app_id") && is_word(i + 1, "is") && (i + 2 < tokens.size()) && tokens[i + 2].quoted)
+        {
+            app_id = tokens[i + 2].text;
+        }
+    }
+
+    for (; i < tokens.size(); ++i)
+    {
+        if (is_word(i, "else"))
+        {
+            can_restrict = false;
+        }
+    }
+
+    if (can_restrict)
+    {
+        summary.app_id = app_id;
+    }
+
+    return summary;
+}
+
+/**
+ * A list of parsed window rules, indexed by signal and by required app-id, so that applying the rules for
+ * an event only evaluates the rules which can possibly match it. Rules are evaluated in the order they were
+ * added, as without the index.
+ */
+class window_rule_set_t
+{
+  public:
+    void clear()
+    {
+        rules.clear();
+        by_signal.clear();
+        any_signal = {};
+    }
+
+    void add(std::shared_ptr<wf::rule_t> rule, const std::string& text)
+    {
+        auto summary = summarize_window_rule(text);
+        auto& bucket = summary.signal.empty() ? any_signal : by_signal[summary.signal];
+        if (summary.app_id)
+        {
+            bucket.by_app_id[*summary.app_id].push_back(rules.size());
+        } else
+        {
+            bucket.generic.push_back(rules.size());
+        }
+
+        rules.push_back(std::move(rule));
+    }
+
+    size_t size() const
+    {
+        return rules.size();
+    }
+
+    /**
+     * Call the callback with each rule which may apply to a view with the given app-id on the given signal.
+     */
+    template<class Callback>
+    void for_each_candidate(const std::string& signal, const std::string& app_id, Callback callback) const
+    {
+        std::vector<size_t> candidates;
+        any_signal.collect(app_id, candidates);
+        auto it = by_signal.find(signal);
+        if (it != by_signal.end())
+        {
+            it->second.collect(app_id, candidates);
+        }
+
+        std::sort(candidates.begin(), candidates.end());
+
+        // Collect the rules before calling the callback, which may reload (and clear) the rules.
+        std::vector<std::shared_ptr<wf::rule_t>> candidate_rules;
+        candidate_rules.reserve(candidates.size());
+        for (auto i : candidates)
+        {
+            candidate_rules.push_back(rules[i]);
+        }
+
+        for (auto& rule : candidate_rules)
+        {
+            callback(*rule);
+        }
+    }
+
+  private:
+    struct bucket_t
+    {
+        std::vector<size_t> generic;
+        std::unordered_map<std::string, std::vector<size_t>> by_app_id;
+
+        void collect(const std::string& app_id, std::vector<size_t>& out) const
+        {
+            out.insert(out.end(), generic.begin(), generic.end());
+            auto it = by_app_id.find(app_id);
+            if (it != by_app_id.end())
+            {
+                out.insert(out.end(), it->second.begin(), it->second.end());
+            }
+        }
+    };
+
+    std::vector<std::shared_ptr<wf::rule_t>> rules;
+    std::unordered_map<std::string, bucket_t> by_signal;
+    bucket_t any_signal;
+};
+
+/**
+ * An access interface which remembers the properties it has looked up, so that evaluating many rules for
+ * the same view looks up each property once. The cached values must be invalidated whenever the view may
+ * have changed, for example after an action was executed.
+ */
+class cached_access_interface_t : public access_interface_t
+{
+  public:
+    cached_access_interface_t(access_interface_t& source) : source(source)
+    {}
+
+    variant_t get(const std::string & identifier, bool & error) override
+    {
+        auto it = values.find(identifier);
+        if (it == values.end())
+        {
+            bool source_error = false;
+            auto value = source.get(identifier, source_error);
+            it = values.emplace(identifier, std::make_pair(value, source_error)).first;
+        }
+
+        error = it->second.second;
+        return it->second.first;
+    }
+
+    void invalidate()
+    {
+        values.clear();
+    }
+
+  private:
+    access_interface_t& source;
+    std::unordered_map<std::string, std::pair<variant_t, bool>> values;
+};
+
+/**
+ * Forwards actions to another action interface and invalidates a property cache after each of them.
+ */
+class invalidating_action_interface_t : public action_interface_t
+{
+  public:
+    invalidating_action_interface_t(action_interface_t& target, cached_access_interface_t& cache) :
+        target(target), cache(cache)
+    {}
+
+    bool execute(const std::string & name, const std::vector<variant_t> & args) override
+    {
+        bool error = target.execute(name, args);
+        cache.invalidate();
+        return error;
+    }
+
+  private:
+    action_interface_t& target;
+    cached_access_interface_t& cache;
+};
+} // End namespace wf.
+
+#endif // WINDOW_RULES_RULE_SET_HPP
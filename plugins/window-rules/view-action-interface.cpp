@@ -8,6 +8,7 @@
 #include "wayfire/util/log.hpp"
 #include "wayfire/view-transform.hpp"
 #include "wayfire/output-layout.hpp"
+#include "wayfire/unstable/wlr-surface-node.hpp"
 #include "../wm-actions/wm-actions-signals.hpp"
 #include <wayfire/plugins/common/util.hpp>
 #include <wayfire/window-manager.hpp>
@@ -91,6 +92,20 @@ bool view_action_interface_t::execute(const std::string & name,
                 _set_geometry_ppt(std::get<1>(geometry), std::get<2>(geometry),
                     std::get<3>(geometry), std::get<4>(geometry));
             }
+        } else if (id == "max_fps")
+        {
+            // set max_fps <fps> [unfocused]
+            auto fps = _expect_int(args, 1);
+            bool only_unfocused = (args.size() > 2) && wf::is_string(args.at(2)) &&
+                (wf::get_string(args.at(2)) == "unfocused");
+            if (!std::get<0>(fps) || (args.size() > 3) || ((args.size() == 3) && !only_unfocused))
+            {
+                LOGE("View action interface: Invalid arguments for set max_fps, expected an integer",
+                    " optionally followed by unfocused.");
+                return true;
+            }
+
+            _set_max_fps(std::get<1>(fps), only_unfocused);
         } else
         {
             LOGE("View action interface: Unsupported set operation to identifier ",
@@ -265,6 +280,11 @@ void view_action_interface_t::_make_sticky()
     _view->set_sticky(1);
 }
 
+void view_action_interface_t::_set_max_fps(int max_fps, bool only_unfocused)
+{
+    wf::scene::set_frame_rate_cap(_view, max_fps, only_unfocused);
+}
+
 void view_action_interface_t::_always_on_top()
 {
     wf::wm_actions_set_above_state_signal data;
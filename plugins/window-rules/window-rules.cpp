@@ -17,6 +17,7 @@
 
 #include "lambda-rules-registration.hpp"
 #include "view-action-interface.hpp"
+#include "rule-set.hpp"
 #include "wayfire/signal-provider.hpp"
 
 class wayfire_window_rules_t : public wf::per_output_plugin_instance_t
@@ -61,11 +62,15 @@ class wayfire_window_rules_t : public wf::per_output_plugin_instance_t
         setup_rules_from_config();
     };
 
-    std::vector<std::shared_ptr<wf::rule_t>> _rules;
+    wf::window_rule_set_t _rules;
 
     wf::view_access_interface_t _access_interface;
     wf::view_action_interface_t _action_interface;
 
+    // The parsed rules look up view properties through a cache, which is dropped after each action.
+    wf::cached_access_interface_t _cached_access{_access_interface};
+    wf::invalidating_action_interface_t _cached_action{_action_interface, _cached_access};
+
     nonstd::observer_ptr<wf::lambda_rules_registrations_t> _lambda_registrations;
 };
 
@@ -111,16 +116,19 @@ void wayfire_window_rules_t::apply(const std::string & signal, wayfire_view view
         return;
     }
 
-    for (const auto & rule : _rules)
+    _cached_access.invalidate();
+    _rules.for_each_candidate(signal, view->get_app_id(), [&] (wf::rule_t& rule)
     {
         _access_interface.set_view(view);
         _action_interface.set_view(view);
-        auto error = rule->apply(signal, _access_interface, _action_interface);
+        auto error = rule.apply(signal, _cached_access, _cached_action);
         if (error)
         {
             LOGE("Window-rules: Error while executing rule on ", signal, " signal.");
         }
-    }
+    });
+
+    _cached_access.invalidate();
 
     auto bounds = _lambda_registrations->rules();
     auto begin  = std::get<0>(bounds);
@@ -130,6 +138,12 @@ void wayfire_window_rules_t::apply(const std::string & signal, wayfire_view view
         auto registration = std::get<1>(*begin);
         bool error = false;
 
+        if (!registration->signal.empty() && (registration->signal != signal))
+        {
+            ++begin;
+            continue;
+        }
+
         // Assume we will use the view access interface.
         _access_interface.set_view(view);
         wf::access_interface_t & access_iface = _access_interface;
@@ -191,7 +205,7 @@ void wayfire_window_rules_t::setup_rules_from_config()
         auto rule = wf::rule_parser_t().parse(_lexer);
         if (rule != nullptr)
         {
-            _rules.push_back(rule);
+            _rules.add(rule, rule_str);
         }
     }
 }
@@ -37,55 +37,75 @@
 
 #include "wobbly.h"
 
-#define GRID_WIDTH  4
-#define GRID_HEIGHT 4
+/* The physics are integrated in steps of this many milliseconds. */
+#define WOBBLY_TIMESTEP 15.0f
 
-#define MODEL_MAX_SPRINGS (GRID_WIDTH * GRID_HEIGHT * 2)
+/* Upper bound on the time simulated in a single frame, to avoid huge bursts of
+ * steps after a stall. */
+#define WOBBLY_MAX_FRAME_TIME 1000
 
 typedef struct _xy_pair {
     float x, y;
 } Point, Vector;
 
-typedef struct _Edge {
-    float next, prev;
-
-    float start;
-    float end;
-
-    float attract;
-    float velocity;
-} Edge;
-
-typedef struct _Object {
-    Vector	 force;
-    Point	 position;
-    Vector	 velocity;
-    float	 theta;
-    int		 immobile;
-    Edge	 vertEdge;
-    Edge	 horzEdge;
-} Object;
-
-typedef struct _Spring {
-    Object *a;
-    Object *b;
-    Vector offset;
-} Spring;
-
+/*
+ * A spring model for a single window. The objects and springs of all models are
+ * stored in the shared world below, the model only remembers which range of the
+ * world it owns.
+ */
 typedef struct _Model {
-    Object	 *objects;
-    int		 numObjects;
-    Spring	 springs[MODEL_MAX_SPRINGS];
-    int		 numSprings;
-    Object	 *anchorObject;
-    float	 steps;
-    Point	 topLeft;
-    Point	 bottomRight;
+    int   gridWidth;
+    int   gridHeight;
+    int   firstObject;
+    int   numObjects;
+    int   firstSpring;
+    int   numSprings;
+    int   anchorObject; /* relative to firstObject, -1 if there is none */
+    int   wobbly;       /* WobblyInitial | WobblyForce | WobblyVelocity */
+    int   stepped;      /* whether the world stepped the model since the last paint */
+    Point topLeft;
+    Point bottomRight;
 } Model;
 
+/*
+ * All wobbly models, stored as structure of arrays so that every spring and every
+ * object of all wobbling windows can be updated in one pass per step.
+ */
+typedef struct _World {
+    float *positionX, *positionY;
+    float *velocityX, *velocityY;
+    float *forceX, *forceY;
+    float *mobile;        /* 1.0f if the object moves in the current frame, 0.0f otherwise */
+    float *velocitySum;   /* per-object sums over the steps of the current frame */
+    float *forceSum;
+    unsigned char *immobile;
+    int   numObjects;
+    int   maxObjects;
+
+    int   *springA, *springB;
+    float *springOffsetX, *springOffsetY;
+    int   numSprings;
+    int   maxSprings;
+
+    Model **models;
+    int   numModels;
+    int   maxModels;
+
+    float        steps;
+    unsigned int lastTime;
+    int          lastActive;
+} World;
+
+static World world;
+
+#define PX(model, i) world.positionX[(model)->firstObject + (i)]
+#define PY(model, i) world.positionY[(model)->firstObject + (i)]
+#define VX(model, i) world.velocityX[(model)->firstObject + (i)]
+#define VY(model, i) world.velocityY[(model)->firstObject + (i)]
+#define IMMOBILE(model, i) world.immobile[(model)->firstObject + (i)]
+
 typedef struct _WobblyWindow {
     Model        *model;
-    int          wobbly;
     int	        grabbed;
     int	       velocity;
     int         grab_dx;
@@ -97,32 +117,171 @@ typedef struct _WobblyWindow {
 #define WobblyForce    (1L << 1)
 #define WobblyVelocity (1L << 2)
 
-static void objectInit(Object *object, float positionX, float positionY,
-        float velocityX, float velocityY)
+static int growArray(void **array, size_t elementSize, int count)
 {
-    object->force.x = 0;
-    object->force.y = 0;
+    void *result = realloc(*array, elementSize * count);
+    if (!result)
+        return 0;
+
+    *array = result;
+    return 1;
+}
+
+static int worldReserve(int numObjects, int numSprings)
+{
+    int max;
+
+    if (world.numObjects + numObjects > world.maxObjects)
+    {
+        max = 2 * (world.numObjects + numObjects);
+        if (!growArray((void**)&world.positionX, sizeof(float), max) ||
+            !growArray((void**)&world.positionY, sizeof(float), max) ||
+            !growArray((void**)&world.velocityX, sizeof(float), max) ||
+            !growArray((void**)&world.velocityY, sizeof(float), max) ||
+            !growArray((void**)&world.forceX, sizeof(float), max) ||
+            !growArray((void**)&world.forceY, sizeof(float), max) ||
+            !growArray((void**)&world.mobile, sizeof(float), max) ||
+            !growArray((void**)&world.velocitySum, sizeof(float), max) ||
+            !growArray((void**)&world.forceSum, sizeof(float), max) ||
+            !growArray((void**)&world.immobile, sizeof(unsigned char), max))
+            return 0;
+
+        world.maxObjects = max;
+    }
 
-    object->position.x = positionX;
-    object->position.y = positionY;
+    if (world.numSprings + numSprings > world.maxSprings)
+    {
+        max = 2 * (world.numSprings + numSprings);
+        if (!growArray((void**)&world.springA, sizeof(int), max) ||
+            !growArray((void**)&world.springB, sizeof(int), max) ||
+            !growArray((void**)&world.springOffsetX, sizeof(float), max) ||
+            !growArray((void**)&world.springOffsetY, sizeof(float), max))
+            return 0;
+
+        world.maxSprings = max;
+    }
 
-    object->velocity.x = velocityX;
-    object->velocity.y = velocityY;
+    if (world.numModels + 1 > world.maxModels)
+    {
+        max = 2 * (world.numModels + 1);
+        if (!growArray((void**)&world.models, sizeof(Model*), max))
+            return 0;
 
-    object->theta    = 0;
-    object->immobile = 0;
+        world.maxModels = max;
+    }
 
-    object->vertEdge.next = 0.0f;
-    object->horzEdge.next = 0.0f;
+    return 1;
 }
 
-static void springInit(Spring *spring, Object *a, Object *b,
-	    float offsetX, float offsetY)
+static int worldAddModel(Model *model)
 {
-    spring->a	     = a;
-    spring->b	     = b;
-    spring->offset.x = offsetX;
-    spring->offset.y = offsetY;
+    if (!worldReserve(model->numObjects, model->numSprings))
+        return 0;
+
+    model->firstObject = world.numObjects;
+    model->firstSpring = world.numSprings;
+    world.numObjects += model->numObjects;
+    world.numSprings += model->numSprings;
+    world.models[world.numModels++] = model;
+
+    return 1;
+}
+
+#define FREE_ARRAY(array) \
+    do { free(array); (array) = NULL; } while (0)
+
+/* Release the storage of the world once it has no models left. */
+static void worldFree(void)
+{
+    FREE_ARRAY(world.positionX);
+    FREE_ARRAY(world.positionY);
+    FREE_ARRAY(world.velocityX);
+    FREE_ARRAY(world.velocityY);
+    FREE_ARRAY(world.forceX);
+    FREE_ARRAY(world.forceY);
+    FREE_ARRAY(world.mobile);
+    FREE_ARRAY(world.velocitySum);
+    FREE_ARRAY(world.forceSum);
+    FREE_ARRAY(world.immobile);
+    world.maxObjects = 0;
+
+    FREE_ARRAY(world.springA);
+    FREE_ARRAY(world.springB);
+    FREE_ARRAY(world.springOffsetX);
+    FREE_ARRAY(world.springOffsetY);
+    world.maxSprings = 0;
+
+    FREE_ARRAY(world.models);
+    world.maxModels = 0;
+}
+
+#define REMOVE_RANGE(array, first, count, total) \
+    memmove(&(array)[first], &(array)[(first) + (count)], \
+        sizeof(*(array)) * ((total) - (first) - (count)))
+
+static void worldRemoveModel(Model *model)
+{
+    int i, o = model->firstObject, no = model->numObjects;
+    int s = model->firstSpring, ns = model->numSprings;
+
+    REMOVE_RANGE(world.positionX, o, no, world.numObjects);
+    REMOVE_RANGE(world.positionY, o, no, world.numObjects);
+    REMOVE_RANGE(world.velocityX, o, no, world.numObjects);
+    REMOVE_RANGE(world.velocityY, o, no, world.numObjects);
+    REMOVE_RANGE(world.forceX, o, no, world.numObjects);
+    REMOVE_RANGE(world.forceY, o, no, world.numObjects);
+    REMOVE_RANGE(world.mobile, o, no, world.numObjects);
+    REMOVE_RANGE(world.velocitySum, o, no, world.numObjects);
+    REMOVE_RANGE(world.forceSum, o, no, world.numObjects);
+    REMOVE_RANGE(world.immobile, o, no, world.numObjects);
+    world.numObjects -= no;
+
+    REMOVE_RANGE(world.springA, s, ns, world.numSprings);
+    REMOVE_RANGE(world.springB, s, ns, world.numSprings);
+    REMOVE_RANGE(world.springOffsetX, s, ns, world.numSprings);
+    REMOVE_RANGE(world.springOffsetY, s, ns, world.numSprings);
+    world.numSprings -= ns;
+
+    for (i = s; i < world.numSprings; i++)
+    {
+        world.springA[i] -= no;
+        world.springB[i] -= no;
+    }
+
+    for (i = 0; i < world.numModels; i++)
+    {
+        if (world.models[i]->firstObject > o)
+        {
+            world.models[i]->firstObject -= no;
+            world.models[i]->firstSpring -= ns;
+        }
+    }
+
+    for (i = 0; i < world.numModels; i++)
+    {
+        if (world.models[i] == model)
+        {
+            REMOVE_RANGE(world.models, i, 1, world.numModels);
+            world.numModels--;
+            break;
+        }
+    }
+
+    if (world.numModels == 0)
+        worldFree();
+}
+
+static void objectInit(Model *model, int i, float positionX, float positionY)
+{
+    int o = model->firstObject + i;
+
+    world.positionX[o] = positionX;
+    world.positionY[o] = positionY;
+    world.velocityX[o] = 0;
+    world.velocityY[o] = 0;
+    world.forceX[o]    = 0;
+    world.forceY[o]    = 0;
+    world.immobile[o]  = 0;
 }
 
 static void modelCalcBounds(Model *model)
@@ -136,63 +295,53 @@ static void modelCalcBounds(Model *model)
 
     for (i = 0; i < model->numObjects; i++)
     {
-        if (model->objects[i].position.x < model->topLeft.x)
-            model->topLeft.x = model->objects[i].position.x;
-        else if (model->objects[i].position.x > model->bottomRight.x)
-            model->bottomRight.x = model->objects[i].position.x;
-
-        if (model->objects[i].position.y < model->topLeft.y)
-            model->topLeft.y = model->objects[i].position.y;
-        else if (model->objects[i].position.y > model->bottomRight.y)
-            model->bottomRight.y = model->objects[i].position.y;
+        if (PX(model, i) < model->topLeft.x)
+            model->topLeft.x = PX(model, i);
+        if (PX(model, i) > model->bottomRight.x)
+            model->bottomRight.x = PX(model, i);
+
+        if (PY(model, i) < model->topLeft.y)
+            model->topLeft.y = PY(model, i);
+        if (PY(model, i) > model->bottomRight.y)
+            model->bottomRight.y = PY(model, i);
     }
 }
 
-static void modelAddSpring(Model *model, Object *a, Object *b,
-		float offsetX, float offsetY)
+static void modelSetAnchor(Model *model, int anchor)
 {
-    Spring *spring;
+    if (model->anchorObject >= 0)
+        IMMOBILE(model, model->anchorObject) = 0;
 
-    spring = &model->springs[model->numSprings];
-    model->numSprings++;
-
-    springInit (spring, a, b, offsetX, offsetY);
+    model->anchorObject = anchor;
+    if (anchor >= 0)
+        IMMOBILE(model, anchor) = 1;
 }
 
 static void modelSetMiddleAnchor(Model *model, int x, int y,
         int width, int height)
 {
+    int   gridWidth = model->gridWidth, gridHeight = model->gridHeight;
     float gx, gy;
 
-    gx = ((GRID_WIDTH  - 1) / 2 * width)  / (float) (GRID_WIDTH  - 1);
-    gy = ((GRID_HEIGHT - 1) / 2 * height) / (float) (GRID_HEIGHT - 1);
-
-    if (model->anchorObject)
-        model->anchorObject->immobile = 0;
+    gx = ((gridWidth  - 1) / 2 * width)  / (float) (gridWidth  - 1);
+    gy = ((gridHeight - 1) / 2 * height) / (float) (gridHeight - 1);
 
-    model->anchorObject =
-        &model->objects[GRID_WIDTH * ((GRID_HEIGHT-1)/2) + (GRID_WIDTH-1)/ 2];
-    model->anchorObject->position.x = x + gx;
-    model->anchorObject->position.y = y + gy;
-
-    model->anchorObject->immobile = 1;
+    modelSetAnchor(model, gridWidth * ((gridHeight - 1) / 2) + (gridWidth - 1) / 2);
+    PX(model, model->anchorObject) = x + gx;
+    PY(model, model->anchorObject) = y + gy;
 }
 
 static void modelSetTopAnchor(Model *model, int x, int y,
         int width)
 {
+    int   gridWidth = model->gridWidth;
     float gx;
 
-    gx = ((GRID_WIDTH  - 1) / 2 * width)  / (float) (GRID_WIDTH  - 1);
-
-    if (model->anchorObject)
-	model->anchorObject->immobile = 0;
-
-    model->anchorObject = &model->objects[(GRID_WIDTH-1)/ 2];
-    model->anchorObject->position.x = x + gx;
-    model->anchorObject->position.y = y;
+    gx = ((gridWidth - 1) / 2 * width) / (float) (gridWidth - 1);
 
-    model->anchorObject->immobile = 1;
+    modelSetAnchor(model, (gridWidth - 1) / 2);
+    PX(model, model->anchorObject) = x + gx;
+    PY(model, model->anchorObject) = y;
 }
 
 static void modelInitObjects(Model *model, int x, int y, int width, int height)
@@ -200,49 +349,53 @@ static void modelInitObjects(Model *model, int x, int y, int width, int height)
     int	  gridX, gridY, i = 0;
     float gw, gh;
 
-    gw = GRID_WIDTH  - 1;
-    gh = GRID_HEIGHT - 1;
+    gw = model->gridWidth  - 1;
+    gh = model->gridHeight - 1;
 
-    for (gridY = 0; gridY < GRID_HEIGHT; gridY++)
+    for (gridY = 0; gridY < model->gridHeight; gridY++)
     {
-        for (gridX = 0; gridX < GRID_WIDTH; gridX++)
+        for (gridX = 0; gridX < model->gridWidth; gridX++)
         {
-            objectInit (&model->objects[i],
+            objectInit (model, i,
                     x + (gridX * width) / gw,
-                    y + (gridY * height) / gh,
-                    0, 0);
+                    y + (gridY * height) / gh);
             i++;
         }
     }
 
-    if (!model->anchorObject)
+    if (model->anchorObject < 0)
         modelSetMiddleAnchor (model, x, y, width, height);
 }
 
 static void modelInitSprings(Model *model, int width, int height)
 {
-    int   gridX, gridY, i = 0;
+    int   gridX, gridY, i = 0, s = model->firstSpring;
+    int   o = model->firstObject;
     float hpad, vpad;
 
-    model->numSprings = 0;
+    hpad = ((float) width) / (model->gridWidth  - 1);
+    vpad = ((float) height) / (model->gridHeight - 1);
 
-    hpad = ((float) width) / (GRID_WIDTH  - 1);
-    vpad = ((float) height) / (GRID_HEIGHT - 1);
-
-    for (gridY = 0; gridY < GRID_HEIGHT; gridY++)
+    for (gridY = 0; gridY < model->gridHeight; gridY++)
     {
-        for (gridX = 0; gridX < GRID_WIDTH; gridX++)
+        for (gridX = 0; gridX < model->gridWidth; gridX++)
         {
             if (gridX > 0)
             {
-                modelAddSpring (model, &model->objects[i - 1],
-                        &model->objects[i], hpad, 0);
+                world.springA[s] = o + i - 1;
+                world.springB[s] = o + i;
+                world.springOffsetX[s] = hpad;
+                world.springOffsetY[s] = 0;
+                s++;
             }
 
             if (gridY > 0)
             {
-                modelAddSpring (model, &model->objects[i - GRID_WIDTH],
-                        &model->objects[i], 0, vpad);
+                world.springA[s] = o + i - model->gridWidth;
+                world.springB[s] = o + i;
+                world.springOffsetX[s] = 0;
+                world.springOffsetY[s] = vpad;
+                s++;
             }
 
             i++;
@@ -250,7 +403,8 @@ static void modelInitSprings(Model *model, int width, int height)
     }
 }
 
-static Model * createModel(int x, int y, int width, int height)
+static Model * createModel(int x, int y, int width, int height,
+        int gridWidth, int gridHeight)
 {
     Model *model;
 
@@ -258,17 +412,19 @@ static Model * createModel(int x, int y, int width, int height)
     if (!model)
         return 0;
 
-    model->numObjects = GRID_WIDTH * GRID_HEIGHT;
-    model->objects = malloc (sizeof (Object) * model->numObjects);
-    if (!model->objects)
+    model->gridWidth  = gridWidth;
+    model->gridHeight = gridHeight;
+    model->numObjects = gridWidth * gridHeight;
+    model->numSprings = (gridWidth - 1) * gridHeight + gridWidth * (gridHeight - 1);
+    if (!worldAddModel(model))
     {
         free (model);
         return 0;
     }
 
-    model->anchorObject = 0;
-    model->numSprings = 0;
-    model->steps = 0;
+    model->anchorObject = -1;
+    model->wobbly = 0;
+    model->stepped = 0;
 
     modelInitObjects (model, x, y, width, height);
     modelInitSprings (model, width, height);
@@ -277,126 +433,191 @@ static Model * createModel(int x, int y, int width, int height)
     return model;
 }
 
-static void objectApplyForce(Object *object, float fx, float fy)
+static void destroyModel(Model *model)
 {
-    object->force.x += fx;
-    object->force.y += fy;
+    worldRemoveModel(model);
+    free(model);
 }
 
-static void springExertForces(Spring *spring, float k)
-{
-    Vector da, db;
-    Vector a, b;
+/*
+ * Step every object of every model in the world. Objects of models which are
+ * not wobbling have mobile == 0 and stay where they are.
+ */
+static void worldStep(float friction, float k)
+{
+    int   i;
+    const int numSprings = world.numSprings, numObjects = world.numObjects;
+
+    const int *restrict springA = world.springA;
+    const int *restrict springB = world.springB;
+    const float *restrict offsetX = world.springOffsetX;
+    const float *restrict offsetY = world.springOffsetY;
+
+    float *restrict px = world.positionX;
+    float *restrict py = world.positionY;
+    float *restrict vx = world.velocityX;
+    float *restrict vy = world.velocityY;
+    float *restrict fx = world.forceX;
+    float *restrict fy = world.forceY;
+    const float *restrict mobile = world.mobile;
+    float *restrict velocitySum = world.velocitySum;
+    float *restrict forceSum = world.forceSum;
+
+    for (i = 0; i < numSprings; i++)
+    {
+        const int a = springA[i], b = springB[i];
+        const float dx = 0.5f * k * (px[b] - px[a] - offsetX[i]);
+        const float dy = 0.5f * k * (py[b] - py[a] - offsetY[i]);
+
+        fx[a] += dx;
+        fy[a] += dy;
+        fx[b] -= dx;
+        fy[b] -= dy;
+    }
+
+    for (i = 0; i < numObjects; i++)
+    {
+        const float m = mobile[i];
+        const float forceX = fx[i] - friction * vx[i];
+        const float forceY = fy[i] - friction * vy[i];
 
-    a = spring->a->position;
-    b = spring->b->position;
+        vx[i] = m * (vx[i] + forceX / WOBBLY_MASS);
+        vy[i] = m * (vy[i] + forceY / WOBBLY_MASS);
 
-    da.x = 0.5f * (b.x - a.x - spring->offset.x);
-    da.y = 0.5f * (b.y - a.y - spring->offset.y);
+        px[i] += vx[i];
+        py[i] += vy[i];
 
-    db.x = 0.5f * (a.x - b.x + spring->offset.x);
-    db.y = 0.5f * (a.y - b.y + spring->offset.y);
+        velocitySum[i] += fabsf(vx[i]) + fabsf(vy[i]);
+        forceSum[i] += m * (fabsf(forceX) + fabsf(forceY));
 
-    objectApplyForce (spring->a, k * da.x, k * da.y);
-    objectApplyForce (spring->b, k * db.x, k * db.y);
+        fx[i] = 0.0f;
+        fy[i] = 0.0f;
+    }
 }
 
-static float modelStepObject(Object *object, float friction, float *force)
+/*
+ * Advance all wobbling models to the given time. Calling this several times with
+ * the same time (for ex. once for each wobbling window) steps the world only once.
+ */
+static void worldAdvance(float friction, float k, unsigned int now)
 {
-    object->theta += 0.05f;
+    int   i, j, steps, active = 0;
+    unsigned int elapsed;
+    Model *model;
 
-    if (object->immobile)
+    for (i = 0; i < world.numModels; i++)
     {
-        object->velocity.x = 0.0f;
-        object->velocity.y = 0.0f;
-        object->force.x = 0.0f;
-        object->force.y = 0.0f;
-
-        *force = 0.0f;
-        return 0.0f;
+        if (world.models[i]->wobbly & (WobblyInitial | WobblyVelocity | WobblyForce))
+            active = 1;
     }
-    else
+
+    if (!active)
     {
-        object->force.x -= friction * object->velocity.x;
-        object->force.y -= friction * object->velocity.y;
+        world.lastTime = now;
+        world.lastActive = 0;
+        return;
+    }
 
-        object->velocity.x += object->force.x / WOBBLY_MASS;
-        object->velocity.y += object->force.y / WOBBLY_MASS;
+    if (world.lastActive)
+    {
+        /* Already advanced for this frame */
+        if (now <= world.lastTime)
+            return;
+
+        elapsed = now - world.lastTime;
+        if (elapsed > WOBBLY_MAX_FRAME_TIME)
+            elapsed = WOBBLY_MAX_FRAME_TIME;
+    } else
+    {
+        /* Coming from idle, the time since the last frame says nothing. */
+        elapsed = 16;
+    }
 
-        object->position.x += object->velocity.x;
-        object->position.y += object->velocity.y;
+    world.lastTime = now;
+    world.lastActive = active;
 
-        *force = fabs(object->force.x) + fabs(object->force.y);
+    world.steps += elapsed / WOBBLY_TIMESTEP;
+    steps = floor (world.steps);
+    world.steps -= steps;
 
-        object->force.x = 0.0f;
-        object->force.y = 0.0f;
+    if (!steps)
+        return;
 
-        return fabs(object->velocity.x) + fabs(object->velocity.y);
+    for (i = 0; i < world.numModels; i++)
+    {
+        model = world.models[i];
+        active = model->wobbly & (WobblyInitial | WobblyVelocity | WobblyForce);
+        for (j = model->firstObject; j < model->firstObject + model->numObjects; j++)
+        {
+            world.mobile[j] = (active && !world.immobile[j]) ? 1.0f : 0.0f;
+        }
     }
-}
-
-static int modelStep(Model *model, float friction, float k, float time)
-{
-    int   i, j, steps, wobbly = 0;
-    float velocitySum = 0.0f;
-    float force, forceSum = 0.0f;
-
-    model->steps += time / 15.0f;
-    steps = floor (model->steps);
-    model->steps -= steps;
 
-    if (!steps)
-        return 1;
+    memset(world.velocitySum, 0, sizeof(float) * world.numObjects);
+    memset(world.forceSum, 0, sizeof(float) * world.numObjects);
 
     for (j = 0; j < steps; j++)
+        worldStep(friction, k);
+
+    for (i = 0; i < world.numModels; i++)
     {
-        for (i = 0; i < model->numSprings; i++)
-            springExertForces (&model->springs[i], k);
+        float velocitySum = 0.0f, forceSum = 0.0f, scale;
+
+        model = world.models[i];
+        if (!(model->wobbly & (WobblyInitial | WobblyVelocity | WobblyForce)))
+            continue;
 
-        for (i = 0; i < model->numObjects; i++)
+        for (j = model->firstObject; j < model->firstObject + model->numObjects; j++)
         {
-            velocitySum += modelStepObject(&model->objects[i], friction, &force);
-            forceSum += force;
+            velocitySum += world.velocitySum[j];
+            forceSum += world.forceSum[j];
         }
-    }
 
-    modelCalcBounds (model);
+        /* The thresholds were tuned for a 4x4 grid; the sums grow with the
+         * number of objects. */
+        scale = model->numObjects / 16.0f;
 
-    if (velocitySum > 0.5f)
-        wobbly |= WobblyVelocity;
-    if (forceSum > 20.0f)
-        wobbly |= WobblyForce;
+        model->wobbly = 0;
+        if (velocitySum > 0.5f * scale)
+            model->wobbly |= WobblyVelocity;
+        if (forceSum > 20.0f * scale)
+            model->wobbly |= WobblyForce;
 
-    return wobbly;
+        model->stepped = 1;
+        modelCalcBounds (model);
+    }
+}
+
+static void bernsteinCoefficients(int count, float t, float *coeffs)
+{
+    float binomial = 1.0f;
+    int   i;
+
+    for (i = 0; i < count; i++)
+    {
+        coeffs[i] = binomial * powf(t, i) * powf(1 - t, count - 1 - i);
+        binomial  = binomial * (count - 1 - i) / (i + 1);
+    }
 }
 
 static void bezierPatchEvaluate (Model *model, float u, float v,
         float *patchX, float *patchY)
 {
-    float coeffsU[4], coeffsV[4];
+    float coeffsU[WOBBLY_MAX_GRID_SIZE], coeffsV[WOBBLY_MAX_GRID_SIZE];
     float x, y;
     int   i, j;
 
-    coeffsU[0] = (1 - u) * (1 - u) * (1 - u);
-    coeffsU[1] = 3 * u * (1 - u) * (1 - u);
-    coeffsU[2] = 3 * u * u * (1 - u);
-    coeffsU[3] = u * u * u;
-
-    coeffsV[0] = (1 - v) * (1 - v) * (1 - v);
-    coeffsV[1] = 3 * v * (1 - v) * (1 - v);
-    coeffsV[2] = 3 * v * v * (1 - v);
-    coeffsV[3] = v * v * v;
+    bernsteinCoefficients(model->gridWidth, u, coeffsU);
+    bernsteinCoefficients(model->gridHeight, v, coeffsV);
 
     x = y = 0.0f;
 
-    for (i = 0; i < 4; i++)
+    for (j = 0; j < model->gridHeight; j++)
     {
-        for (j = 0; j < 4; j++)
+        for (i = 0; i < model->gridWidth; i++)
         {
-            x += coeffsU[i] * coeffsV[j] *
-                model->objects[j * GRID_WIDTH + i].position.x;
-            y += coeffsU[i] * coeffsV[j] *
-                model->objects[j * GRID_HEIGHT + i].position.y;
+            x += coeffsU[i] * coeffsV[j] * PX(model, j * model->gridWidth + i);
+            y += coeffsU[i] * coeffsV[j] * PY(model, j * model->gridWidth + i);
         }
     }
 
@@ -411,7 +632,8 @@ static int wobblyEnsureModel(struct wobbly_surface *surface)
     if (!ww->model)
     {
         ww->model = createModel(surface->x, surface->y,
-                surface->width, surface->height);
+                surface->width, surface->height,
+                surface->grid_width, surface->grid_height);
         if (!ww->model)
             return 0;
     }
@@ -419,99 +641,100 @@ static int wobblyEnsureModel(struct wobbly_surface *surface)
     return 1;
 }
 
-static float objectDistance(Object *object, float x, float y)
+static float objectDistance(Model *model, int i, float x, float y)
 {
     float dx, dy;
-    dx = object->position.x - x;
-    dy = object->position.y - y;
+    dx = PX(model, i) - x;
+    dy = PY(model, i) - y;
 
     return sqrt(dx * dx + dy * dy);
 }
 
-static Object *modelFindNearestObject(Model *model, float x, float y)
+static int modelFindNearestObject(Model *model, float x, float y)
 {
-    Object *object = &model->objects[0];
+    int    object = 0;
     float  distance, minDistance = 0.0;
     int    i;
 
     for (i = 0; i < model->numObjects; i++)
     {
-        distance = objectDistance(&model->objects[i], x, y);
+        distance = objectDistance(model, i, x, y);
         if (i == 0 || distance < minDistance)
         {
             minDistance = distance;
-            object = &model->objects[i];
+            object = i;
         }
     }
 
     return object;
 }
 
-static void modelAdjustCorners(Model *model, int x, int y,
-        int width, int height, int make_immobile)
+/* Push the neighbours of the given object away from it (or pull them in). */
+static void modelPushNeighbours(Model *model, int object)
 {
-    Object *o;
-    o = &model->objects[0];
-    o->position.x = x;
-    o->position.y = y;
-    o->immobile = make_immobile;
-
-    o = &model->objects[GRID_WIDTH - 1];
-    o->position.x = x + width;
-    o->position.y = y;
-    o->immobile = make_immobile;
-
-    o = &model->objects[GRID_WIDTH * (GRID_HEIGHT - 1)];
-    o->position.x = x;
-    o->position.y = y + height;
-    o->immobile = make_immobile;
+    int i, s, o = model->firstObject + object;
 
-    o = &model->objects[model->numObjects - 1];
-    o->position.x = x + width;
-    o->position.y = y + height;
-    o->immobile = make_immobile;
+    for (i = 0; i < model->numSprings; i++)
+    {
+        s = model->firstSpring + i;
 
-    if (!model->anchorObject)
-        model->anchorObject = &model->objects[0];
+        if (world.springA[s] == o)
+        {
+            world.velocityX[world.springB[s]] -= world.springOffsetX[s] * 0.05f;
+            world.velocityY[world.springB[s]] -= world.springOffsetY[s] * 0.05f;
+        }
+        else if (world.springB[s] == o)
+        {
+            world.velocityX[world.springA[s]] += world.springOffsetX[s] * 0.05f;
+            world.velocityY[world.springA[s]] += world.springOffsetY[s] * 0.05f;
+        }
+    }
 }
 
-static int modelRemoveEdgeAnchors(Model *model)
+static void modelSetObject(Model *model, int i, int x, int y, int make_immobile)
 {
-    int result = 0;
-    Object *o;
+    PX(model, i) = x;
+    PY(model, i) = y;
+    IMMOBILE(model, i) = make_immobile;
+}
 
-    o = &model->objects[0];
-    if (o != model->anchorObject)
-    {
-        result |= o->immobile;
-        o->immobile = 0;
-    }
+static void modelAdjustCorners(Model *model, int x, int y,
+        int width, int height, int make_immobile)
+{
+    modelSetObject(model, 0, x, y, make_immobile);
+    modelSetObject(model, model->gridWidth - 1, x + width, y, make_immobile);
+    modelSetObject(model, model->gridWidth * (model->gridHeight - 1),
+        x, y + height, make_immobile);
+    modelSetObject(model, model->numObjects - 1,
+        x + width, y + height, make_immobile);
 
-    o = &model->objects[GRID_WIDTH - 1];
-    if (o != model->anchorObject)
-    {
-        result |= o->immobile;
-        o->immobile = 0;
-    }
+    if (model->anchorObject < 0)
+        model->anchorObject = 0;
+}
 
-    o = &model->objects[GRID_WIDTH * (GRID_HEIGHT - 1)];
-    if (o != model->anchorObject)
-    {
-        result |= o->immobile;
-        o->immobile = 0;
-    }
+static int modelRemoveEdgeAnchors(Model *model)
+{
+    int corners[4] = {
+        0,
+        model->gridWidth - 1,
+        model->gridWidth * (model->gridHeight - 1),
+        model->numObjects - 1,
+    };
+    int i, result = 0;
 
-    o = &model->objects[model->numObjects - 1];
-    if (o != model->anchorObject)
+    for (i = 0; i < 4; i++)
     {
-        result |= o->immobile;
-        o->immobile = 0;
+        if (corners[i] != model->anchorObject)
+        {
+            result |= IMMOBILE(model, corners[i]);
+            IMMOBILE(model, corners[i]) = 0;
+        }
     }
 
     return result;
 }
 
-void wobbly_prepare_paint(struct wobbly_surface *surface, int msSinceLastPaint)
+void wobbly_prepare_paint(struct wobbly_surface *surface, unsigned int now)
 {
     WobblyWindow *ww = surface->ww;
     float  friction, springK;
@@ -519,21 +742,16 @@ void wobbly_prepare_paint(struct wobbly_surface *surface, int msSinceLastPaint)
     friction = wobbly_settings_get_friction();
     springK  = wobbly_settings_get_spring_k();
 
-    if (ww->wobbly)
+    worldAdvance(friction, springK, now);
+
+    if (ww->model->stepped)
     {
-        if (ww->wobbly & (WobblyInitial | WobblyVelocity | WobblyForce))
+        ww->model->stepped = 0;
+        if (!ww->model->wobbly)
         {
-            ww->wobbly = modelStep(ww->model, friction, springK,
-                    (ww->wobbly & WobblyVelocity) ?
-                    msSinceLastPaint : 16);
-
-            if (ww->wobbly) {
-                modelCalcBounds(ww->model);
-            } else {
-                surface->x = ww->model->topLeft.x;
-                surface->y = ww->model->topLeft.y;
-                surface->synced = 1;
-            }
+            surface->x = ww->model->topLeft.x;
+            surface->y = ww->model->topLeft.y;
+            surface->synced = 1;
         }
     }
 }
@@ -541,54 +759,25 @@ void wobbly_prepare_paint(struct wobbly_surface *surface, int msSinceLastPaint)
 void wobbly_done_paint(struct wobbly_surface *surface)
 {
     WobblyWindow *ww = (WobblyWindow*)surface->ww;
-    if (ww->wobbly)
+    if (ww->model->wobbly)
     {
         surface->x = ww->model->topLeft.x;
         surface->y = ww->model->topLeft.y;
     }
 }
 
-void wobbly_add_geometry(struct wobbly_surface *surface)
+void wobbly_get_control_points(struct wobbly_surface *surface, float *points, int stride)
 {
     WobblyWindow *ww = surface->ww;
+    Model *model = ww->model;
+    int   x, y;
 
-    float    width, height;
-    float    deformedX, deformedY;
-    int      x, y, iw, ih;
-    float    cell_w, cell_h;
-    GLfloat  *v, *uv;
-
-    if (ww->wobbly)
+    for (y = 0; y < model->gridHeight; y++)
     {
-        width  = surface->width;
-        height = surface->height;
-
-        cell_w = width / surface->x_cells;
-        cell_h = height / surface->y_cells;
-
-        iw = surface->x_cells + 1;
-        ih = surface->y_cells + 1;
-
-        v = realloc(surface->v, sizeof(GLfloat) * 2 * iw * ih);
-        uv = realloc(surface->uv, sizeof(GLfloat) * 2 * iw * ih);
-
-        surface->v = v;
-        surface->uv = uv;
-
-        for (y = 0; y < ih; y++)
+        for (x = 0; x < model->gridWidth; x++)
         {
-            for (x = 0; x < iw; x++)
-            {
-                bezierPatchEvaluate(ww->model,
-                        (x * cell_w) / width, (y * cell_h) / height,
-                        &deformedX, &deformedY);
-
-                *v++ = deformedX;
-                *v++ = deformedY;
-
-                *uv++ = (x * cell_w) / width;
-                *uv++ = 1.0 - ((y * cell_h) / height);
-            }
+            points[2 * (y * stride + x)]     = PX(model, y * model->gridWidth + x);
+            points[2 * (y * stride + x) + 1] = PY(model, y * model->gridWidth + x);
         }
     }
 }
@@ -600,10 +789,12 @@ void wobbly_resize(struct wobbly_surface *surface, int width, int height)
     height = height > 1 ? height : 1;
 
     surface->synced = 0;
-    ww->wobbly |= WobblyInitial;
 
     if (ww->model)
+    {
+        ww->model->wobbly |= WobblyInitial;
         modelInitSprings(ww->model, width, height);
+    }
 
     ww->grab_dx = (ww->grab_dx * width) / surface->width;
     ww->grab_dy = (ww->grab_dy * height) / surface->height;
@@ -617,10 +808,10 @@ void wobbly_move_notify(struct wobbly_surface *surface, int x, int y)
     WobblyWindow *ww = surface->ww;
     if (ww->grabbed)
     {
-        ww->model->anchorObject->position.x = x + ww->grab_dx;
-        ww->model->anchorObject->position.y = y + ww->grab_dy;
+        PX(ww->model, ww->model->anchorObject) = x + ww->grab_dx;
+        PY(ww->model, ww->model->anchorObject) = y + ww->grab_dy;
 
-        ww->wobbly |= WobblyInitial;
+        ww->model->wobbly |= WobblyInitial;
         surface->synced = 0;
     }
 }
@@ -630,30 +821,13 @@ void wobbly_slight_wobble(struct wobbly_surface *surface)
     WobblyWindow *ww = surface->ww;
     if (wobblyEnsureModel(surface))
     {
-        Object *centerObj;
-        Spring *s;
-        int	   i;
+        int centerObj;
 
         centerObj = modelFindNearestObject(ww->model,
             surface->x + surface->width / 2, surface->y + surface->height / 2);
+        modelPushNeighbours(ww->model, centerObj);
 
-        for (i = 0; i < ww->model->numSprings; i++)
-        {
-            s = &ww->model->springs[i];
-
-            if (s->a == centerObj)
-            {
-                s->b->velocity.x -= s->offset.x * 0.05f;
-                s->b->velocity.y -= s->offset.y * 0.05f;
-            }
-            else if (s->b == centerObj)
-            {
-                s->a->velocity.x += s->offset.x * 0.05f;
-                s->a->velocity.y += s->offset.y * 0.05f;
-            }
-        }
-
-        ww->wobbly |= WobblyInitial;
+        ww->model->wobbly |= WobblyInitial;
     }
 }
 
@@ -673,35 +847,16 @@ void wobbly_grab_notify(struct wobbly_surface *surface, int x, int y)
 
     if (wobblyEnsureModel(surface))
     {
-        Spring *s;
-        int	   i;
+        Model *model = ww->model;
 
-        if (ww->model->anchorObject)
-            ww->model->anchorObject->immobile = 0;
-
-        ww->model->anchorObject = modelFindNearestObject(ww->model, x, y);
-        ww->model->anchorObject->immobile = 1;
-        ww->grab_dx = ww->model->anchorObject->position.x - x;
-        ww->grab_dy = ww->model->anchorObject->position.y - y;
+        modelSetAnchor(model, modelFindNearestObject(model, x, y));
+        ww->grab_dx = PX(model, model->anchorObject) - x;
+        ww->grab_dy = PY(model, model->anchorObject) - y;
 
         ww->grabbed = 1;
-        for (i = 0; i < ww->model->numSprings; i++)
-        {
-            s = &ww->model->springs[i];
+        modelPushNeighbours(model, model->anchorObject);
 
-            if (s->a == ww->model->anchorObject)
-            {
-                s->b->velocity.x -= s->offset.x * 0.05f;
-                s->b->velocity.y -= s->offset.y * 0.05f;
-            }
-            else if (s->b == ww->model->anchorObject)
-            {
-                s->a->velocity.x += s->offset.x * 0.05f;
-                s->a->velocity.y += s->offset.y * 0.05f;
-            }
-        }
-
-        ww->wobbly |= WobblyInitial;
+        model->wobbly |= WobblyInitial;
     }
 }
 
@@ -712,12 +867,8 @@ void wobbly_ungrab_notify(struct wobbly_surface *surface)
     {
         if (ww->model)
         {
-            if (ww->model->anchorObject)
-                ww->model->anchorObject->immobile = 0;
-
-            ww->model->anchorObject = NULL;
-
-            ww->wobbly |= WobblyInitial;
+            modelSetAnchor(ww->model, -1);
+            ww->model->wobbly |= WobblyInitial;
         }
 
         surface->synced = 0;
@@ -733,10 +884,18 @@ int wobbly_init(struct wobbly_surface *surface)
         return 0;
 
     ww->model   = 0;
-    ww->wobbly  = 0;
     ww->grabbed = 0;
     ww->state   = 0;
 
+    if (surface->grid_width < WOBBLY_MIN_GRID_SIZE)
+        surface->grid_width = WOBBLY_MIN_GRID_SIZE;
+    if (surface->grid_width > WOBBLY_MAX_GRID_SIZE)
+        surface->grid_width = WOBBLY_MAX_GRID_SIZE;
+    if (surface->grid_height < WOBBLY_MIN_GRID_SIZE)
+        surface->grid_height = WOBBLY_MIN_GRID_SIZE;
+    if (surface->grid_height > WOBBLY_MAX_GRID_SIZE)
+        surface->grid_height = WOBBLY_MAX_GRID_SIZE;
+
     surface->ww = ww;
     if(!wobblyEnsureModel(surface))
     {
@@ -753,9 +912,7 @@ void wobbly_fini(struct wobbly_surface *surface)
 
     if (ww->model)
     {
-        free(ww->model->objects);
-        free(ww->model);
-        free(surface->v);
+        destroyModel(ww->model);
     }
 
     free (ww);
@@ -768,11 +925,8 @@ void wobbly_force_geometry(struct wobbly_surface *surface,
 
     if (wobblyEnsureModel(surface))
     {
-		if (!ww->grabbed && ww->model->anchorObject)
-		{
-		    ww->model->anchorObject->immobile = 0;
-		    ww->model->anchorObject = NULL;
-		}
+        if (!ww->grabbed)
+            modelSetAnchor(ww->model, -1);
 
         surface->x = x;
         surface->y = y;
@@ -780,10 +934,10 @@ void wobbly_force_geometry(struct wobbly_surface *surface,
         surface->height = h > 0 ? h : 1;
         surface->synced = 0;
 
-	    modelInitSprings(ww->model, w, h);
-		modelAdjustCorners(ww->model, x, y, w, h, 1);
+        modelInitSprings(ww->model, w, h);
+        modelAdjustCorners(ww->model, x, y, w, h, 1);
 
-	    ww->wobbly |= WobblyInitial;
+        ww->model->wobbly |= WobblyInitial;
     }
 }
 
@@ -795,7 +949,8 @@ void wobbly_unenforce_geometry(struct wobbly_surface *surface)
     {
         if (modelRemoveEdgeAnchors(ww->model))
         {
-            if (!ww->model->anchorObject || !ww->model->anchorObject->immobile)
+            if (ww->model->anchorObject < 0 ||
+                !IMMOBILE(ww->model, ww->model->anchorObject))
             {
                 modelSetMiddleAnchor(ww->model, surface->x, surface->y,
                     surface->width, surface->height);
@@ -803,7 +958,7 @@ void wobbly_unenforce_geometry(struct wobbly_surface *surface)
             modelInitSprings(ww->model, surface->width, surface->height);
         }
 
-        ww->wobbly |= WobblyInitial;
+        ww->model->wobbly |= WobblyInitial;
     }
 }
 
@@ -814,8 +969,8 @@ void wobbly_translate(struct wobbly_surface *surface, int dx, int dy)
     {
         for (int i = 0; i < ww->model->numObjects; i++)
         {
-            ww->model->objects[i].position.x += dx;
-            ww->model->objects[i].position.y += dy;
+            PX(ww->model, i) += dx;
+            PY(ww->model, i) += dy;
         }
 
         ww->model->topLeft.x += dx;
@@ -837,8 +992,8 @@ void wobbly_scale(struct wobbly_surface *surface, double dx, double dy)
     {
         for (int i = 0; i < ww->model->numObjects; i++)
         {
-            scale(surface->x, &ww->model->objects[i].position.x, dx);
-            scale(surface->y, &ww->model->objects[i].position.y, dy);
+            scale(surface->x, &PX(ww->model, i), dx);
+            scale(surface->y, &PY(ww->model, i), dy);
         }
 
         scale(surface->x, &ww->model->topLeft.x, dx);
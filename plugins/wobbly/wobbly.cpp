@@ -1,7 +1,9 @@
 #include "wayfire/debug.hpp"
 #include "wayfire/opengl.hpp"
 #include "wayfire/region.hpp"
+#include <algorithm>
 #include <memory>
+#include <vector>
 #include <wayfire/plugin.hpp>
 #include <wayfire/signal-definitions.hpp>
 #include <wayfire/core.hpp>
@@ -21,17 +23,65 @@ namespace wobbly_graphics
 {
 namespace
 {
+/* The vertex positions are evaluated from the control points of the spring model, which form a Bezier
+ * patch. The mesh only carries the (u, v) coordinates of each vertex on the patch. */
 const char *vertex_source =
     R"(
 #version 100
-attribute mediump vec2 position;
-attribute mediump vec2 uvPosition;
+attribute highp vec2 patchPosition;
 varying highp vec2 uvpos;
 uniform mat4 MVP;
 
+#define MAX_GRID 8
+
+/* Control points in rows of MAX_GRID points */
+uniform highp vec2 controlPoints[MAX_GRID * MAX_GRID];
+uniform int gridWidth;
+uniform int gridHeight;
+
+void bernstein(int count, highp float t, out highp float coeffs[MAX_GRID])
+{
+    highp float binomial = 1.0;
+    for (int i = 0; i < MAX_GRID; i++)
+    {
+        coeffs[i] = 0.0;
+        if (i < count)
+        {
+            highp float value = binomial;
+            for (int k = 0; k < MAX_GRID - 1; k++)
+            {
+                if (k < i)
+                {
+                    value *= t;
+                } else if (k < count - 1)
+                {
+                    value *= 1.0 - t;
+                }
+            }
+
+            coeffs[i] = value;
+            binomial  = binomial * float(count - 1 - i) / float(i + 1);
+        }
+    }
+}
+
 void main() {
-    gl_Position = MVP * vec4(position.xy, 0.0, 1.0);
-    uvpos = uvPosition;
+    highp float coeffsU[MAX_GRID];
+    highp float coeffsV[MAX_GRID];
+    bernstein(gridWidth, patchPosition.x, coeffsU);
+    bernstein(gridHeight, patchPosition.y, coeffsV);
+
+    highp vec2 position = vec2(0.0);
+    for (int j = 0; j < MAX_GRID; j++)
+    {
+        for (int i = 0; i < MAX_GRID; i++)
+        {
+            position += coeffsU[i] * coeffsV[j] * controlPoints[j * MAX_GRID + i];
+        }
+    }
+
+    gl_Position = MVP * vec4(position, 0.0, 1.0);
+    uvpos = vec2(patchPosition.x, 1.0 - patchPosition.y);
 }
 )";
 
@@ -48,80 +98,133 @@ void main()
     gl_FragColor = get_pixel(uvpos);
 }
 )";
+
+constexpr int MAX_GRID = 8;
+static_assert(MAX_GRID == WOBBLY_MAX_GRID_SIZE, "The shader must have room for all control points");
 }
 
 /**
- * Enumerate the needed triangles for rendering the model
+ * A static tessellation of the unit square, shared by all wobbly views. It is uploaded once and only
+ * regenerated when the grid resolution changes.
  */
-void prepare_geometry(wobbly_surface *model, wf::geometry_t src_box,
-    std::vector<float>& vert, std::vector<float>& uv)
+class mesh_t
 {
-    float x = src_box.x, y = src_box.y, w = src_box.width, h = src_box.height;
-    std::vector<int> idx;
-
-    int per_row = model->x_cells + 1;
-
-    for (int j = 0; j < model->y_cells; j++)
+  public:
+    /* Requires bound opengl context */
+    void ensure_resolution(int cells)
     {
-        for (int i = 0; i < model->x_cells; i++)
+        // Vertex indices must fit in GL_UNSIGNED_SHORT
+        cells = std::clamp(cells, 1, 128);
+        if (cells == this->cells)
         {
-            idx.push_back(i * per_row + j);
-            idx.push_back((i + 1) * per_row + j + 1);
-            idx.push_back(i * per_row + j + 1);
-
-            idx.push_back(i * per_row + j);
-            idx.push_back((i + 1) * per_row + j);
-            idx.push_back((i + 1) * per_row + j + 1);
+            return;
         }
-    }
 
-    if (!model->v || !model->uv)
-    {
-        for (auto id : idx)
+        this->cells = cells;
+        if (!vbo)
         {
-            float tile_w = w / model->x_cells;
-            float tile_h = h / model->y_cells;
+            GL_CALL(glGenBuffers(1, &vbo));
+            GL_CALL(glGenBuffers(1, &ibo));
+        }
 
-            int i = id / per_row;
-            int j = id % per_row;
+        std::vector<float> vertices;
+        for (int j = 0; j <= cells; j++)
+        {
+            for (int i = 0; i <= cells; i++)
+            {
+                vertices.push_back(1.0f * i / cells);
+                vertices.push_back(1.0f * j / cells);
+            }
+        }
 
-            vert.push_back(i * tile_w + x);
-            vert.push_back(j * tile_h + y);
+        std::vector<GLushort> indices;
+        const int per_row = cells + 1;
+        for (int j = 0; j < cells; j++)
+        {
+            for (int i = 0; i < cells; i++)
+            {
+                indices.push_back(j * per_row + i);
+                indices.push_back((j + 1) * per_row + i + 1);
+                indices.push_back((j + 1) * per_row + i);
 
-            uv.push_back(1.0f * i / model->x_cells);
-            uv.push_back(1.0f - 1.0f * j / model->y_cells);
+                indices.push_back(j * per_row + i);
+                indices.push_back(j * per_row + i + 1);
+                indices.push_back((j + 1) * per_row + i + 1);
+            }
         }
-    } else
+
+        index_count = indices.size();
+        GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, vbo));
+        GL_CALL(glBufferData(GL_ARRAY_BUFFER, sizeof(float) * vertices.size(), vertices.data(),
+            GL_STATIC_DRAW));
+        GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo));
+        GL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * indices.size(), indices.data(),
+            GL_STATIC_DRAW));
+        GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, 0));
+        GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+    }
+
+    /* Requires bound opengl context */
+    void free_resources()
     {
-        for (auto i : idx)
+        if (vbo)
         {
-            vert.push_back(model->v[2 * i]);
-            vert.push_back(model->v[2 * i + 1]);
-
-            uv.push_back(model->uv[2 * i]);
-            uv.push_back(model->uv[2 * i + 1]);
+            GL_CALL(glDeleteBuffers(1, &vbo));
+            GL_CALL(glDeleteBuffers(1, &ibo));
         }
+
+        vbo   = ibo = 0;
+        cells = 0;
     }
-}
 
-/* Requires bound opengl context */
-void render_triangles(OpenGL::program_t *program, wf::gles_texture_t tex, glm::mat4 mat, float *pos,
-    float *uv,
-    int cnt)
+    GLuint vbo = 0;
+    GLuint ibo = 0;
+    int index_count = 0;
+
+  private:
+    int cells = 0;
+};
+
+/**
+ * The GL resources of the plugin, shared by all wobbly views.
+ */
+struct resources_t
 {
+    OpenGL::program_t program;
+    mesh_t mesh;
+};
+
+/**
+ * Render the damaged parts of the patch with the given control points.
+ * Requires bound opengl context.
+ */
+void render_patch(resources_t *gl, wf::gles_texture_t tex, const wf::render_target_t& target,
+    const wf::region_t& damage, const float *control_points, int grid_width, int grid_height)
+{
+    auto program = &gl->program;
     program->use(tex.type);
     program->set_active_texture(tex);
+    program->uniformMatrix4f("MVP", wf::gles::render_target_orthographic_projection(target));
+    program->uniform1i("gridWidth", grid_width);
+    program->uniform1i("gridHeight", grid_height);
+    GLint points_loc = glGetUniformLocation(program->get_program_id(tex.type), "controlPoints");
+    GL_CALL(glUniform2fv(points_loc, MAX_GRID * MAX_GRID, control_points));
 
-    program->attrib_pointer("position", 2, 0, pos);
-    program->attrib_pointer("uvPosition", 2, 0, uv);
-    program->uniformMatrix4f("MVP", mat);
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, gl->mesh.vbo));
+    GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gl->mesh.ibo));
+    program->attrib_pointer("patchPosition", 2, 0, nullptr);
 
     GL_CALL(glEnable(GL_BLEND));
     GL_CALL(glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA));
+    for (auto box : damage)
+    {
+        wf::gles::render_target_logic_scissor(target, wlr_box_from_pixman_box(box));
+        GL_CALL(glDrawElements(GL_TRIANGLES, gl->mesh.index_count, GL_UNSIGNED_SHORT, 0));
+    }
 
-    GL_CALL(glDrawArrays(GL_TRIANGLES, 0, 3 * cnt));
     GL_CALL(glDisable(GL_BLEND));
-
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
     program->deactivate();
 }
 }
@@ -131,6 +234,7 @@ namespace wobbly_settings
 wf::option_wrapper_t<double> friction{"wobbly/friction"};
 wf::option_wrapper_t<double> spring_k{"wobbly/spring_k"};
 wf::option_wrapper_t<int> resolution{"wobbly/grid_resolution"};
+wf::option_wrapper_t<int> spring_grid{"wobbly/spring_grid"};
 }
 
 extern "C"
@@ -241,7 +345,6 @@ class iwobbly_state_t
     virtual void translate_model(int dx, int dy)
     {
         wobbly_translate(model.get(), dx, dy);
-        wobbly_add_geometry(model.get());
         bounding_box.x += dx;
         bounding_box.y += dy;
         model->x += dx;
@@ -545,10 +648,10 @@ class wobbly_transformer_node_t : public wf::scene::transformer_base_node_t
 {
   public:
     wobbly_transformer_node_t(wayfire_toplevel_view view,
-        OpenGL::program_t *wobbly_prog) : transformer_base_node_t(false)
+        wobbly_graphics::resources_t *gl) : transformer_base_node_t(false)
     {
         this->view = view;
-        this->wobbly_program = wobbly_prog;
+        this->gl   = gl;
         init_model();
         last_frame = wf::get_current_time();
         view->get_output()->connect(&on_workspace_changed);
@@ -598,7 +701,7 @@ class wobbly_transformer_node_t : public wf::scene::transformer_base_node_t
         view->get_transformed_node()->rem_transformer("wobbly");
     }
 
-    OpenGL::program_t *wobbly_program;
+    wobbly_graphics::resources_t *gl;
 
   private:
     wayfire_toplevel_view view;
@@ -668,16 +771,17 @@ class wobbly_transformer_node_t : public wf::scene::transformer_base_node_t
         model->grabbed = 0;
         model->synced  = 1;
 
-        model->x_cells = wobbly_settings::resolution;
-        model->y_cells = wobbly_settings::resolution;
+        model->grid_width  = wobbly_settings::spring_grid;
+        model->grid_height = wobbly_settings::spring_grid;
 
-        model->v  = NULL;
-        model->uv = NULL;
         wobbly_init(model.get());
     }
 
   public:
-    void update_model()
+    /**
+     * Advance the model to the given frame time.
+     */
+    void update_model(int64_t now)
     {
         view->damage();
 
@@ -688,15 +792,11 @@ class wobbly_transformer_node_t : public wf::scene::transformer_base_node_t
         view->connect(&on_view_geometry_changed);
 
         /* Update all the wobbly model */
-        auto now = wf::get_current_time();
-
         if (now > last_frame)
         {
             view->get_transformed_node()->begin_transform_update();
-            wobbly_prepare_paint(model.get(), now - last_frame);
-            /* Update wobbly geometry */
+            wobbly_prepare_paint(model.get(), now);
             last_frame = now;
-            wobbly_add_geometry(model.get());
             wobbly_done_paint(model.get());
             view->get_transformed_node()->end_transform_update();
         }
@@ -857,7 +957,7 @@ class wobbly_render_instance_t :
     public wf::scene::transformer_render_instance_t<wobbly_transformer_node_t>
 {
     wf::output_t *wo = nullptr;
-    wf::effect_hook_t pre_hook;
+    wf::animation_hook_t animation_hook;
 
   public:
     wobbly_render_instance_t(wobbly_transformer_node_t *self, wf::scene::damage_callback push_damage,
@@ -866,8 +966,12 @@ class wobbly_render_instance_t :
         if (shown_on)
         {
             wo = shown_on;
-            pre_hook = [=] () { self->update_model(); };
-            wo->render->add_effect(&pre_hook, wf::OUTPUT_EFFECT_PRE);
+            animation_hook = [=] (int64_t frame_time)
+            {
+                self->update_model(frame_time);
+                return true;
+            };
+            wo->render->add_animation(&animation_hook);
         }
     }
 
@@ -875,7 +979,7 @@ class wobbly_render_instance_t :
     {
         if (wo)
         {
-            wo->render->rem_effect(&pre_hook);
+            wo->render->rem_animation(&animation_hook);
         }
     }
 
@@ -886,21 +990,15 @@ class wobbly_render_instance_t :
 
     void render(const wf::scene::render_instruction_t& data) override
     {
-        std::vector<float> vert, uv;
-        auto subbox = self->get_children_bounding_box();
-        wobbly_graphics::prepare_geometry(self->model.get(), subbox, vert, uv);
+        float control_points[2 * WOBBLY_MAX_GRID_SIZE * WOBBLY_MAX_GRID_SIZE] = {0};
+        wobbly_get_control_points(self->model.get(), control_points, WOBBLY_MAX_GRID_SIZE);
 
         auto tex = wf::gles_texture_t{get_texture(data.target.scale)};
         data.pass->custom_gles_subpass(data.target, [&]
         {
-            for (auto box : data.damage)
-            {
-                wf::gles::render_target_logic_scissor(data.target, wlr_box_from_pixman_box(box));
-                wobbly_graphics::render_triangles(self->wobbly_program, tex,
-                    wf::gles::render_target_orthographic_projection(data.target),
-                    vert.data(), uv.data(),
-                    self->model->x_cells * self->model->y_cells * 2);
-            }
+            self->gl->mesh.ensure_resolution(wobbly_settings::resolution);
+            wobbly_graphics::render_patch(self->gl, tex, data.target, data.damage, control_points,
+                self->model->grid_width, self->model->grid_height);
         });
     }
 };
@@ -934,7 +1032,7 @@ class wayfire_wobbly : public wf::plugin_interface_t
         wf::get_core().connect(&wobbly_changed);
         wf::gles::run_in_context_if_gles([&]
         {
-            program.compile(wobbly_graphics::vertex_source, wobbly_graphics::frag_source);
+            gl.program.compile(wobbly_graphics::vertex_source, wobbly_graphics::frag_source);
         });
     }
 
@@ -951,7 +1049,7 @@ class wayfire_wobbly : public wf::plugin_interface_t
             !tr_manager->get_transformer<wobbly_transformer_node_t>("wobbly"))
         {
             tr_manager->add_transformer(
-                std::make_shared<wobbly_transformer_node_t>(data->view, &program),
+                std::make_shared<wobbly_transformer_node_t>(data->view, &gl),
                 wf::TRANSFORMER_HIGHLEVEL, "wobbly");
         }
 
@@ -1016,12 +1114,13 @@ class wayfire_wobbly : public wf::plugin_interface_t
 
         wf::gles::run_in_context_if_gles([&]
         {
-            program.free_resources();
+            gl.program.free_resources();
+            gl.mesh.free_resources();
         });
     }
 
   private:
-    OpenGL::program_t program;
+    wobbly_graphics::resources_t gl;
 };
 
 DECLARE_WAYFIRE_PLUGIN(wayfire_wobbly);
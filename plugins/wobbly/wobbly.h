@@ -7,13 +7,13 @@
 
 #include <stdio.h>
 
-#include <GLES2/gl2.h>
-
 #define MINIMAL_FRICTION 0.1
 #define MAXIMAL_FRICTION 10.0
 #define MINIMAL_SPRING_K 0.1
 #define MAXIMAL_SPRING_K 10.0
 #define WOBBLY_MASS 15.0
+#define WOBBLY_MIN_GRID_SIZE 4
+#define WOBBLY_MAX_GRID_SIZE 8
 
 double wobbly_settings_get_friction();
 double wobbly_settings_get_spring_k();
@@ -22,11 +22,10 @@ struct wobbly_surface
 {
    void *ww;
    int x, y, width, height;
-   int x_cells, y_cells;
+   /* Number of control points of the spring model in each direction,
+    * between WOBBLY_MIN_GRID_SIZE and WOBBLY_MAX_GRID_SIZE. */
+   int grid_width, grid_height;
    int grabbed, synced;
-   int vertex_count;
-
-   GLfloat *v, *uv;
 };
 
 struct wobbly_rect
@@ -47,9 +46,14 @@ void wobbly_ungrab_notify(struct wobbly_surface *surface);
 void wobbly_scale(struct wobbly_surface *surface, double dx, double dy);
 void wobbly_resize(struct wobbly_surface *surface, int width, int height);
 void wobbly_move_notify(struct wobbly_surface *surface, int x, int y);
-void wobbly_prepare_paint(struct wobbly_surface *surface, int msSinceLastPaint);
+/* Advance the models of all surfaces to the time @now (in milliseconds) and
+ * update the state of @surface. All models are stepped together, so calling
+ * this for every surface in the same frame steps the physics only once. */
+void wobbly_prepare_paint(struct wobbly_surface *surface, unsigned int now);
 void wobbly_done_paint(struct wobbly_surface *surface);
-void wobbly_add_geometry(struct wobbly_surface *surface);
+/* Write the current positions of the control points of the model to @points,
+ * as (x, y) pairs in rows of @stride points. */
+void wobbly_get_control_points(struct wobbly_surface *surface, float *points, int stride);
 struct wobbly_rect wobbly_boundingbox(struct wobbly_surface *surface);
 
 void wobbly_force_geometry(struct wobbly_surface *surface,
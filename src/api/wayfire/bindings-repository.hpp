@@ -25,6 +25,19 @@ struct parse_activator_extension_signal
     std::any tag;
 };
 
+/**
+ * Counters for the binding lookups done on key, button and axis events.
+ */
+struct binding_lookup_stats_t
+{
+    /** The number of key, button and axis events looked up. */
+    uint64_t lookups = 0;
+    /** The number of lookups answered from the index, without looking at the registered bindings. */
+    uint64_t index_hits = 0;
+    /** The number of bindings compared against an event while (re)building the index. */
+    uint64_t comparisons = 0;
+};
+
 /**
  * bindings_repository_t is responsible for managing a list of all bindings in
  * Wayfire, and for calling these bindings on the corresponding events.
@@ -107,6 +120,17 @@ class bindings_repository_t
      */
     void reparse_extensions();
 
+    /**
+     * Key, button and axis bindings are looked up in an index by modifiers and key or button, which is
+     * rebuilt after bindings are added or removed, or their options change.
+     *
+     * @return The lookup counters since startup or the last reset.
+     */
+    binding_lookup_stats_t get_lookup_stats() const;
+
+    /** Reset the lookup counters to zero. */
+    void reset_lookup_stats();
+
     struct impl;
     std::unique_ptr<impl> priv;
 };
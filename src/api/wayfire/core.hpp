@@ -19,6 +19,7 @@ namespace wf
 class view_interface_t;
 class toplevel_view_interface_t;
 class window_manager_t;
+class view_registry_t;
 class workspace_set_t;
 class config_backend_t;
 
@@ -117,6 +118,7 @@ class compositor_core_t : public wf::object_base_t, public signal::provider_t
     std::unique_ptr<wf::seat_t> seat;
     std::unique_ptr<wf::txn::transaction_manager_t> tx_manager;
     std::unique_ptr<wf::window_manager_t> default_wm;
+    std::unique_ptr<wf::view_registry_t> view_registry;
 
     /**
      * Various protocols supported by wlroots
@@ -258,7 +260,8 @@ class compositor_core_t : public wf::object_base_t, public signal::provider_t
         nonstd::observer_ptr<wf::touch::gesture_t> gesture) = 0;
 
     /**
-     * @deprecated. Use tracking_allocator_t<view_interface_t>::get_all()
+     * @deprecated. Use view_registry->get_all_views(), which does not copy the list, or one of the
+     *   view_registry indexes.
      *
      * @return A list of all views core manages, regardless of their output,
      *  properties, etc.
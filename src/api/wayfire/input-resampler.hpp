@@ -0,0 +1,164 @@
+#pragma once
+
+#include <wayfire/geometry.hpp>
+#include <wayfire/util.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+
+namespace wf
+{
+/**
+ * Convert the 32-bit millisecond timestamp of an input event (CLOCK_MONOTONIC, as used by libinput and
+ * wlroots) to the time base of wf::get_current_time(), taking care of the wraparound.
+ */
+inline int64_t input_event_time_to_msec(uint32_t time_msec)
+{
+    const int64_t now = wf::get_current_time();
+    int64_t time = (now & ~(int64_t)UINT32_MAX) | time_msec;
+    if (time > now + INT32_MAX)
+    {
+        time -= (int64_t)UINT32_MAX + 1;
+    }
+
+    return time;
+}
+
+/**
+ * Resamples a stream of timestamped input positions (for example touch points, tablet tools or accumulated
+ * gesture deltas) at arbitrary points in time, typically once per output frame.
+ *
+ * Input devices and outputs run at unrelated rates, so consumers which use the latest event on each frame
+ * move by a varying number of events per frame, which is visible as jitter. Sampling the stream at a fixed
+ * point relative to the frame instead gives a steady motion.
+ *
+ * Between two samples, the position is interpolated linearly. After the newest sample, the position is
+ * extrapolated with the velocity of the last two samples, for at most max_prediction milliseconds.
+ */
+class input_resampler_t
+{
+  public:
+    /** The number of samples kept, which is also the number of intervals used to estimate the event rate. */
+    static constexpr size_t HISTORY_SIZE = 5;
+
+    /**
+     * @param max_prediction The maximal time in milliseconds for which positions are extrapolated.
+     */
+    input_resampler_t(int64_t max_prediction = 0) : max_prediction(max_prediction)
+    {}
+
+    /** Set the maximal time in milliseconds for which positions are extrapolated. */
+    void set_max_prediction(int64_t max_prediction)
+    {
+        this->max_prediction = std::max<int64_t>(max_prediction, 0);
+    }
+
+    /** Remove all samples, for example when a new gesture begins. */
+    void reset()
+    {
+        samples.clear();
+    }
+
+    /**
+     * Add a new sample. Samples must be added in the order of their timestamps, older samples are ignored.
+     * A sample with the same timestamp as the newest sample replaces it.
+     */
+    void add_sample(int64_t time, wf::pointf_t position)
+    {
+        if (!samples.empty() && (time <= samples.back().time))
+        {
+            if (time == samples.back().time)
+            {
+                samples.back().position = position;
+            }
+
+            return;
+        }
+
+        samples.push_back({time, position});
+        if (samples.size() > HISTORY_SIZE)
+        {
+            samples.pop_front();
+        }
+    }
+
+    /** @return Whether no samples have been added since the last reset. */
+    bool empty() const
+    {
+        return samples.empty();
+    }
+
+    /** @return The newest sample's position, or (0, 0) if there are no samples. */
+    wf::pointf_t get_latest() const
+    {
+        return samples.empty() ? wf::pointf_t{0, 0} : samples.back().position;
+    }
+
+    /**
+     * @return The average time in milliseconds between the stored samples, or 0 if there are less than two
+     *   samples.
+     */
+    int64_t get_sample_interval() const
+    {
+        if (samples.size() < 2)
+        {
+            return 0;
+        }
+
+        return (samples.back().time - samples.front().time) / (int64_t)(samples.size() - 1);
+    }
+
+    /**
+     * @return The position at the given time, or (0, 0) if there are no samples. Times before the oldest
+     *   stored sample return its position.
+     */
+    wf::pointf_t sample_at(int64_t time) const
+    {
+        if (samples.empty())
+        {
+            return {0, 0};
+        }
+
+        if (time <= samples.front().time)
+        {
+            return samples.front().position;
+        }
+
+        if (time >= samples.back().time)
+        {
+            if ((samples.size() < 2) || (max_prediction == 0))
+            {
+                return samples.back().position;
+            }
+
+            const auto& a = samples[samples.size() - 2];
+            const auto& b = samples.back();
+            time = std::min(time, b.time + max_prediction);
+            return interpolate(a, b, time);
+        }
+
+        auto next = std::upper_bound(samples.begin(), samples.end(), time,
+            [] (int64_t time, const sample_t& sample) { return time < sample.time; });
+        return interpolate(*(next - 1), *next, time);
+    }
+
+  private:
+    struct sample_t
+    {
+        int64_t time;
+        wf::pointf_t position;
+    };
+
+    std::deque<sample_t> samples;
+    int64_t max_prediction;
+
+    static wf::pointf_t interpolate(const sample_t& a, const sample_t& b, int64_t time)
+    {
+        const double alpha = (double)(time - a.time) / (b.time - a.time);
+        return {
+            a.position.x + (b.position.x - a.position.x) * alpha,
+            a.position.y + (b.position.y - a.position.y) * alpha,
+        };
+    }
+};
+}
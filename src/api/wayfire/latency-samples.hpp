@@ -0,0 +1,82 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace wf
+{
+/**
+ * Percentiles of a set of latencies, in microseconds.
+ */
+struct latency_percentiles_t
+{
+    /** The number of latencies recorded since the last reset. */
+    uint64_t count = 0;
+    int64_t p50_us = 0;
+    int64_t p90_us = 0;
+    int64_t p99_us = 0;
+    int64_t max_us = 0;
+};
+
+/**
+ * Keeps the most recent CAPACITY latencies, to compute their percentiles.
+ */
+class latency_samples_t
+{
+  public:
+    static constexpr size_t CAPACITY = 1024;
+
+    /** Record a latency in microseconds. */
+    void add(int64_t latency_us)
+    {
+        if (samples.size() < CAPACITY)
+        {
+            samples.push_back(latency_us);
+        } else
+        {
+            samples[count % CAPACITY] = latency_us;
+        }
+
+        ++count;
+    }
+
+    void reset()
+    {
+        samples.clear();
+        count = 0;
+    }
+
+    /**
+     * @return The percentiles of the most recent CAPACITY latencies (nearest-rank method), together with
+     *   the number of all latencies recorded since the last reset.
+     */
+    latency_percentiles_t get_percentiles() const
+    {
+        latency_percentiles_t result;
+        result.count = count;
+        if (samples.empty())
+        {
+            return result;
+        }
+
+        auto sorted = samples;
+        std::sort(sorted.begin(), sorted.end());
+        auto percentile = [&] (int p)
+        {
+            size_t rank = (sorted.size() * p + 99) / 100;
+            return sorted[std::max<size_t>(rank, 1) - 1];
+        };
+
+        result.p50_us = percentile(50);
+        result.p90_us = percentile(90);
+        result.p99_us = percentile(99);
+        result.max_us = sorted.back();
+        return result;
+    }
+
+  private:
+    std::vector<int64_t> samples;
+    uint64_t count = 0;
+};
+}
@@ -45,8 +45,7 @@ class object_base_t
      * If your type doesn't have one, use store_data + get_data
      */
     template<class T>
-    nonstd::observer_ptr<T> get_data_safe(
-        std::string name = typeid(T).name())
+    nonstd::observer_ptr<T> get_data_safe(std::string name)
     {
         auto data = get_data<T>(name);
         if (data)
@@ -60,28 +59,58 @@ class object_base_t
         }
     }
 
+    /** Same as get_data_safe(name), with the data stored for the type T. */
+    template<class T>
+    nonstd::observer_ptr<T> get_data_safe()
+    {
+        auto data = get_data<T>();
+        if (data)
+        {
+            return data;
+        } else
+        {
+            store_data<T>(std::make_unique<T>());
+
+            return get_data<T>();
+        }
+    }
+
     /* Retrieve custom data stored with the given name. If no such
      * data exists, NULL is returned */
     template<class T>
-    nonstd::observer_ptr<T> get_data(
-        std::string name = typeid(T).name())
+    nonstd::observer_ptr<T> get_data(std::string name)
+    {
+        return nonstd::make_observer(dynamic_cast<T*>(_fetch_data(_find_slot(name))));
+    }
+
+    /* Retrieve custom data stored for the type T, or NULL */
+    template<class T>
+    nonstd::observer_ptr<T> get_data()
     {
-        return nonstd::make_observer(dynamic_cast<T*>(_fetch_data(name)));
+        // The slot is shared with the string-keyed API and with same-named types of other plugins, so the
+        // stored data is not necessarily a T.
+        return nonstd::make_observer(dynamic_cast<T*>(_fetch_data(type_slot<T>())));
     }
 
     /* Assigns the given data to the given name */
     template<class T>
-    void store_data(std::unique_ptr<T> stored_data,
-        std::string name = typeid(T).name())
+    void store_data(std::unique_ptr<T> stored_data, std::string name)
+    {
+        _store_data(std::move(stored_data), _register_slot(name));
+    }
+
+    /* Assigns the given data to the type T */
+    template<class T>
+    void store_data(std::unique_ptr<T> stored_data)
     {
-        _store_data(std::move(stored_data), name);
+        _store_data(std::move(stored_data), type_slot<T>());
     }
 
     /* Returns true if there is saved data under the given name */
     template<class T>
     bool has_data()
     {
-        return has_data(typeid(T).name());
+        return _fetch_data(type_slot<T>()) != nullptr;
     }
 
     /** @return true if there is saved data with the given name */
@@ -94,22 +123,26 @@ class object_base_t
     template<class T>
     void erase_data()
     {
-        erase_data(typeid(T).name());
+        _erase_data(type_slot<T>());
     }
 
     /* Erase the saved data from the store and return the pointer */
     template<class T>
-    std::unique_ptr<T> release_data(
-        std::string name = typeid(T).name())
+    std::unique_ptr<T> release_data(std::string name)
+    {
+        return std::unique_ptr<T>(dynamic_cast<T*>(_fetch_erase(_find_slot(name))));
+    }
+
+    /* Erase the saved data for the type T from the store and return the pointer */
+    template<class T>
+    std::unique_ptr<T> release_data()
     {
-        if (!has_data(name))
+        if (!get_data<T>())
         {
             return {nullptr};
         }
 
-        auto stored = _fetch_erase(name);
-
-        return std::unique_ptr<T>(dynamic_cast<T*>(stored));
+        return std::unique_ptr<T>(static_cast<T*>(_fetch_erase(type_slot<T>())));
     }
 
     virtual ~object_base_t();
@@ -126,14 +159,33 @@ class object_base_t
     void _clear_data();
 
   private:
-    /** Just get the data under the given name, or nullptr, if it does not exist */
-    custom_data_t *_fetch_data(std::string name);
-    /** Get the data under the given name, and release the pointer, deleting
-     * the entry in the map */
-    custom_data_t *_fetch_erase(std::string name);
-
-    /** Store the given data under the given name */
-    void _store_data(std::unique_ptr<custom_data_t> data, std::string name);
+    /**
+     * Data is stored in slots. Each name (and each type, by the name of its type_info) is assigned a slot
+     * the first time data is stored under it. The slot of a type is cached in each binary, so typed accesses
+     * do not need to hash or even build the name.
+     */
+    static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+    /** Get the slot for the given name, registering it if necessary. */
+    static uint32_t _register_slot(const std::string& name);
+    /** Get the slot for the given name, or INVALID_SLOT if no data was ever stored under it. */
+    static uint32_t _find_slot(const std::string& name);
+
+    template<class T>
+    static uint32_t type_slot()
+    {
+        static const uint32_t slot = _register_slot(typeid(T).name());
+        return slot;
+    }
+
+    /** Just get the data in the given slot, or nullptr, if it does not exist */
+    custom_data_t *_fetch_data(uint32_t slot);
+    /** Get the data in the given slot, and release the pointer, removing it from the object */
+    custom_data_t *_fetch_erase(uint32_t slot);
+    /** Remove and destroy the data in the given slot */
+    void _erase_data(uint32_t slot);
+
+    /** Store the given data in the given slot */
+    void _store_data(std::unique_ptr<custom_data_t> data, uint32_t slot);
 
     class obase_impl;
     std::unique_ptr<obase_impl> obase_priv;
@@ -46,6 +46,19 @@ enum output_effect_type_t
 using post_hook_t = std::function<void (wf::auxilliary_buffer_t& source,
     const wf::render_buffer_t& destination)>;
 
+/**
+ * Animation hooks are driven by the output's animation clock. All animation hooks of an output are called
+ * once per frame, before the OUTPUT_EFFECT_PRE hooks, and the output keeps requesting new frames while at
+ * least one animation is running. Animations damage the nodes they change themselves, so that the damage
+ * also reaches other places where the nodes are shown (for example workspace streams).
+ *
+ * @param frame_time The predicted presentation time of the frame, in milliseconds (same clock as
+ *   wf::get_current_time()). It is the same for all animations in a frame.
+ *
+ * @return Whether the animation is still running. Finished animations are removed automatically.
+ */
+using animation_hook_t = std::function<bool (int64_t frame_time)>;
+
 /**
  * The frame-done signal is emitted on an output when the frame has been completed (regardless of whether new
  * content was painted or not).
@@ -103,6 +116,26 @@ class render_manager
      */
     void rem_effect(effect_hook_t *hook);
 
+    /**
+     * Add a new animation hook. The hook will be called starting with the next frame.
+     *
+     * @param hook The hook callback
+     */
+    void add_animation(animation_hook_t *hook);
+
+    /**
+     * Remove an animation hook. No-op if the hook isn't active.
+     *
+     * @param hook The hook to be removed.
+     */
+    void rem_animation(animation_hook_t *hook);
+
+    /**
+     * @return The predicted presentation time of the current frame (in milliseconds), as passed to
+     *   animation hooks. Outside of the repaint cycle, this is the frame time of the last frame.
+     */
+    int64_t get_frame_time() const;
+
     /**
      * Add a new post hook.
      *
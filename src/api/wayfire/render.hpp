@@ -60,6 +60,9 @@ struct render_buffer_t
 struct buffer_allocation_hints_t
 {
     bool needs_alpha = true;
+    // Allow formats with reduced color precision (16 bits per pixel), if the renderer supports them.
+    // Only applies to buffers which do not need alpha.
+    bool low_precision = false;
 };
 
 /**
@@ -138,6 +141,9 @@ struct auxilliary_buffer_t
 
     // The wlr_texture creating from this framebuffer.
     wlr_texture *texture = NULL;
+
+    // The hints used for the current buffer.
+    buffer_allocation_hints_t hints;
 };
 
 /**
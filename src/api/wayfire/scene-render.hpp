@@ -17,6 +17,9 @@ namespace scene
 class node_t;
 using node_ptr = std::shared_ptr<node_t>;
 
+// Defined in scene.hpp
+void invalidate_input_bounds();
+
 class render_instance_t;
 
 /**
@@ -160,6 +163,8 @@ struct node_damage_signal
 template<class NodePtr>
 inline void damage_node(NodePtr node, wf::region_t damage)
 {
+    // Damage usually means that the node changed, so its input bounds may have changed too.
+    invalidate_input_bounds();
     node_damage_signal data;
     data.region = damage;
     node->emit(&data);
@@ -170,6 +170,18 @@ class node_t : public std::enable_shared_from_this<node_t>,
      */
     virtual std::optional<input_node_t> find_node_at(const wf::pointf_t& at);
 
+    /**
+     * Get a box outside of which the node and its children never accept input, in the coordinate system the
+     * node resides in, or nothing if the node does not guarantee such a bound (the default).
+     *
+     * The default find_node_at() implementation skips children whose input bounds do not contain the point.
+     * The bounds are cached until the next scenegraph update, damage or frame, see invalidate_input_bounds().
+     */
+    virtual std::optional<wf::geometry_t> get_input_bounds()
+    {
+        return {};
+    }
+
     /**
      * Figure out which node should receive keyboard focus on the given output.
      *
@@ -379,6 +391,11 @@ class node_t : public std::enable_shared_from_this<node_t>,
     std::vector<std::shared_ptr<node_t>> children;
 
     void set_children_unchecked(std::vector<node_ptr> new_list);
+
+  private:
+    std::optional<wf::geometry_t> cached_input_bounds;
+    uint64_t cached_input_bounds_serial = 0;
+    const std::optional<wf::geometry_t>& get_cached_input_bounds();
 };
 
 /**
@@ -524,5 +541,13 @@ void set_node_enabled(wf::scene::node_ptr node, bool enabled);
  * @param flags A bit mask consisting of flags defined in the @update_flag enum.
  */
 void update(node_ptr changed_node, uint32_t flags);
+
+/**
+ * Invalidate the cached input bounds of all nodes (see node_t::get_input_bounds()).
+ *
+ * This is done automatically on scenegraph updates, node damage, view movement and every output frame, so it
+ * is needed only for nodes whose input region changes without any of those.
+ */
+void invalidate_input_bounds();
 }
 } // namespace wf
@@ -4,6 +4,7 @@
 #include <wayfire/scene.hpp>
 #include <wayfire/nonstd/wlroots.hpp>
 #include <wayfire/view.hpp>
+#include <wayfire/latency-samples.hpp>
 
 namespace wf
 {
@@ -32,6 +33,38 @@ struct keyboard_focus_changed_signal
 struct seat_activity_signal
 {};
 
+/**
+ * Counters for the relative pointer motion events handled by a seat.
+ * See the input/coalesce_pointer_motion option.
+ */
+struct pointer_motion_stats_t
+{
+    /** Relative motion events received from pointer devices. */
+    uint64_t events = 0;
+    /** Times the compositor processed pointer motion (moved the cursor, updated focus, etc.) */
+    uint64_t dispatched = 0;
+    /** Events which were merged into the motion of a later frame instead of being processed on their own. */
+    uint64_t coalesced = 0;
+};
+
+/**
+ * Latencies of input events, from the device timestamp until the first presented frame which can reflect
+ * them. See the input/trace_latency option.
+ */
+struct input_latency_stats_t
+{
+    /** From the device timestamp until the event was sent to the client, after bindings and plugins. */
+    latency_percentiles_t handling;
+    /** From sending the event until the client committed its surface. */
+    latency_percentiles_t client;
+    /** From the client commit until the output presented the frame containing it. */
+    latency_percentiles_t present;
+    /** From the device timestamp until the frame was presented. */
+    latency_percentiles_t total;
+    /** Traced events which never reached the screen (no commit in time, frame not presented, etc.) */
+    uint64_t dropped = 0;
+};
+
 /**
  * A seat represents a group of input devices (mouse, keyboard, etc.) which logically belong together.
  * Each seat has its own keyboard, touch, pointer and tablet focus.
@@ -127,6 +160,26 @@ class seat_t
      */
     void notify_activity();
 
+    /**
+     * Get the counters for the relative pointer motion events handled by the seat.
+     */
+    pointer_motion_stats_t get_pointer_motion_stats() const;
+
+    /**
+     * Reset the counters returned by get_pointer_motion_stats().
+     */
+    void reset_pointer_motion_stats();
+
+    /**
+     * Get the latencies of the input events traced since the last reset.
+     */
+    input_latency_stats_t get_input_latency_stats() const;
+
+    /**
+     * Reset the latencies returned by get_input_latency_stats().
+     */
+    void reset_input_latency_stats();
+
     /**
      * Create and initialize a new seat.
      */
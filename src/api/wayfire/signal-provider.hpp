@@ -4,6 +4,7 @@
 #include <memory>
 #include <cassert>
 #include <typeindex>
+#include <vector>
 
 namespace wf
 {
@@ -117,6 +118,23 @@ class connection_t final : public connection_base_t
     callback current_callback;
 };
 
+namespace detail
+{
+/**
+ * The connections of a provider for a single signal type.
+ *
+ * Connections which are removed while the signal is being emitted are only cleared, and the list is
+ * compacted when the (outermost) emission finishes. Connections added during an emission are not called
+ * until the next emission.
+ */
+struct connection_list_t
+{
+    std::vector<connection_base_t*> connections;
+    int emitting = 0;
+    bool has_removed = false;
+};
+}
+
 class provider_t
 {
   public:
@@ -144,12 +162,22 @@ class provider_t
     template<class SignalType>
     void emit(SignalType *data)
     {
-        this->for_each_connection(index<SignalType>(), [&] (connection_base_t *tc)
+        auto list = find_connections(index<SignalType>());
+        if (!list)
+        {
+            return;
+        }
+
+        // Only connection_t<SignalType> are stored in the list for SignalType, see connect().
+        emit_guard_t guard{list};
+        const size_t count = list->connections.size();
+        for (size_t i = 0; i < count; i++)
         {
-            auto real_type = dynamic_cast<connection_t<SignalType>*>(tc);
-            assert(real_type);
-            real_type->emit(data);
-        });
+            if (auto connection = list->connections[i])
+            {
+                static_cast<connection_t<SignalType>*>(connection)->emit(data);
+            }
+        }
     }
 
     provider_t();
@@ -170,8 +198,26 @@ class provider_t
         return std::type_index(typeid(SignalType));
     }
 
+    struct emit_guard_t
+    {
+        detail::connection_list_t *list;
+        emit_guard_t(detail::connection_list_t *list) : list(list)
+        {
+            list->emitting++;
+        }
+
+        ~emit_guard_t()
+        {
+            if ((--list->emitting == 0) && list->has_removed)
+            {
+                compact(list);
+            }
+        }
+    };
+
     void connect_base(std::type_index type, connection_base_t *callback);
-    void for_each_connection(std::type_index type, std::function<void(connection_base_t*)> func);
+    detail::connection_list_t *find_connections(std::type_index type);
+    static void compact(detail::connection_list_t *list);
     void disconnect_other_side(connection_base_t *callback);
 
     struct impl;
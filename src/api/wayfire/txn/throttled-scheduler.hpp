@@ -0,0 +1,61 @@
+#pragma once
+#include <wayfire/txn/transaction-manager.hpp>
+#include <functional>
+
+namespace wf
+{
+namespace txn
+{
+/**
+ * Schedules transactions for a single object, so that at most one of them is in flight (pending or committed)
+ * at any time.
+ *
+ * Requests which arrive while a transaction for the object is in flight are collapsed into a single new
+ * transaction, which is scheduled as soon as the object's current transaction has been applied. Objects
+ * commit their pending state when the transaction is committed, so the new transaction carries the latest
+ * state.
+ *
+ * This is useful for interactive operations like resizing, where every input event would otherwise send a
+ * new configure event, flooding slow clients.
+ */
+class throttled_scheduler_t
+{
+  public:
+    using transaction_factory_t = std::function<transaction_uptr()>;
+
+    /**
+     * Create a scheduler for the given object.
+     *
+     * @param manager The transaction manager to schedule transactions with.
+     * @param object The object to schedule transactions for.
+     * @param factory A function which creates the (empty) transactions to schedule. By default,
+     *   transaction_t::create() is used.
+     */
+    throttled_scheduler_t(transaction_manager_t& manager, transaction_object_sptr object,
+        transaction_factory_t factory = nullptr);
+    ~throttled_scheduler_t();
+
+    /**
+     * Request a transaction for the object. If the object already has a transaction in flight, the request
+     * is deferred until it has been applied.
+     */
+    void schedule();
+
+    /**
+     * Schedule a deferred request immediately, without waiting for the object's current transaction. This is
+     * useful at the end of an interactive operation, to make sure that the final state is not delayed.
+     */
+    void flush();
+
+    /** @return Whether there is a deferred request. */
+    bool has_deferred() const;
+
+    /** @return Whether the object has a pending or committed transaction. */
+    bool is_in_flight() const;
+
+  private:
+    struct impl;
+    std::unique_ptr<impl> priv;
+};
+}
+}
@@ -3,11 +3,43 @@
 #include "wayfire/signal-provider.hpp"
 #include "wayfire/txn/transaction-object.hpp"
 #include <wayfire/txn/transaction.hpp>
+#include <array>
+#include <vector>
 
 namespace wf
 {
 namespace txn
 {
+/**
+ * A histogram of latencies. Bucket i counts latencies below 2^i milliseconds (and at least 2^(i-1)
+ * milliseconds), the last bucket counts all longer latencies.
+ */
+struct latency_histogram_t
+{
+    static constexpr int NUM_BUCKETS = 12;
+    std::array<uint64_t, NUM_BUCKETS> buckets = {};
+    uint64_t count   = 0;
+    int64_t total_us = 0;
+    int64_t max_us   = 0;
+
+    void add(int64_t latency_us);
+};
+
+/**
+ * Transaction latency statistics for a single client.
+ */
+struct client_transaction_stats_t
+{
+    client_info_t client;
+
+    // Time from commit until the object of the client was ready.
+    latency_histogram_t ready;
+    // Time from commit until the transaction containing the object was applied.
+    latency_histogram_t apply;
+    // Number of transactions which timed out while waiting for the client.
+    uint64_t timeouts = 0;
+};
+
 /*
  * The transaction manager keeps track of all committed and pending transactions and ensures that there is at
  * most one committed transaction for a given object.
@@ -50,6 +82,16 @@ class transaction_manager_t : public signal::provider_t
      */
     bool is_object_committed(transaction_object_sptr object) const;
 
+    /**
+     * Get the latency statistics of all clients which took part in transactions since the last reset.
+     */
+    std::vector<client_transaction_stats_t> get_client_stats() const;
+
+    /**
+     * Clear the latency statistics.
+     */
+    void reset_client_stats();
+
     struct impl;
     std::unique_ptr<impl> priv;
 };
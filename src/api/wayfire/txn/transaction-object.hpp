@@ -8,6 +8,16 @@ namespace wf
 {
 namespace txn
 {
+/**
+ * Information about the client which an object depends on, used to attribute transaction latency.
+ */
+struct client_info_t
+{
+    std::string app_id;
+    // The pid of the client, or -1 if unknown.
+    int pid = -1;
+};
+
 /**
  * A transaction object participates in the transactions system.
  *
@@ -45,6 +55,15 @@ class transaction_object_t : public signal::provider_t
      */
     virtual void apply() = 0;
 
+    /**
+     * Get the client which has to cooperate for the object to become ready, for example the client of a
+     * toplevel. Objects which do not depend on a client return an empty app_id and pid -1.
+     */
+    virtual client_info_t get_client_info() const
+    {
+        return {};
+    }
+
     virtual ~transaction_object_t() = default;
 };
 
@@ -3,6 +3,8 @@
 #include "wayfire/signal-provider.hpp"
 #include "wayfire/util.hpp"
 #include <wayfire/txn/transaction-object.hpp>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace wf
 {
@@ -50,14 +52,36 @@ class transaction_t : public signal::provider_t
      */
     void commit();
 
+    /**
+     * Get the time when the transaction was committed, or -1 if it was not committed yet.
+     * All transaction times are in microseconds, measured with a monotonic clock.
+     */
+    int64_t get_commit_time() const;
+
+    /**
+     * Get the time when the given object became ready, or -1 if it did not become ready (yet).
+     */
+    int64_t get_ready_time(transaction_object_t *object) const;
+
+    /**
+     * Get the time when the transaction was applied, or -1 if it was not applied yet.
+     */
+    int64_t get_apply_time() const;
+
     virtual ~transaction_t() = default;
 
   private:
     std::vector<transaction_object_sptr> objects;
+    // Same as objects, for fast lookup in add_object().
+    std::unordered_set<transaction_object_t*> object_set;
     int count_ready_objects = 0;
     uint64_t timeout;
     timer_setter_t timer_setter;
 
+    int64_t commit_time = -1;
+    int64_t apply_time  = -1;
+    std::unordered_map<transaction_object_t*, int64_t> ready_times;
+
     void apply(bool did_timeout);
     wf::signal::connection_t<object_ready_signal> on_object_ready;
 };
@@ -66,6 +90,8 @@ using transaction_uptr = std::unique_ptr<transaction_t>;
 
 /**
  * A signal emitted on a transaction as soon as it has been applied.
+ * It is also emitted on the transaction manager after the transaction has been removed from the list of
+ * committed transactions.
  */
 struct transaction_applied_signal
 {
@@ -6,6 +6,7 @@
 #include <wayfire/scene.hpp>
 #include <wayfire/nonstd/wlroots-full.hpp>
 #include <wayfire/output-layout.hpp>
+#include <wayfire/view.hpp>
 
 namespace wf
 {
@@ -38,6 +39,32 @@ struct surface_state_t
     surface_state_t& operator =(surface_state_t&& other);
 };
 
+/**
+ * A limit on the rate at which the surfaces of a view receive frame done events. It is stored as custom data
+ * on the view and applies to the main surface of the view and its subsurfaces.
+ *
+ * When a surface node would send frame done less than 1/max_fps seconds after the previous one, the event
+ * is suppressed and sent once the interval has elapsed instead.
+ */
+struct frame_rate_cap_t : public wf::custom_data_t
+{
+    frame_rate_cap_t();
+    ~frame_rate_cap_t();
+
+    /** The maximal number of frame done events per second sent to each surface of the view. */
+    int max_fps = 0;
+    /** Whether the cap applies only while the view is not activated. */
+    bool only_unfocused = false;
+    /** The number of frame done events which were suppressed because of the cap. */
+    uint64_t suppressed = 0;
+};
+
+/**
+ * Cap the frame rate of the view's surfaces, or remove the cap if max_fps is not positive.
+ * The counter of suppressed frame done events is kept when an existing cap is changed.
+ */
+void set_frame_rate_cap(wayfire_view view, int max_fps, bool only_unfocused);
+
 /**
  * An implementation of node_t for wlr_surfaces.
  *
@@ -67,6 +94,11 @@ class wlr_surface_node_t : public node_t, public zero_copy_texturable_node_t
 
     wlr_surface *get_surface() const;
     void apply_state(surface_state_t&& state);
+
+    /**
+     * Send frame done to the surface, or schedule it for the next vblank if delay_until_vblank is set and the
+     * surface is visible. Frame done events are suppressed as needed to respect the view's frame_rate_cap_t.
+     */
     void send_frame_done(bool delay_until_vblank);
 
   private:
@@ -87,6 +119,13 @@ class wlr_surface_node_t : public node_t, public zero_copy_texturable_node_t
     wf::wl_listener_wrapper on_surface_destroyed;
     wf::wl_listener_wrapper on_surface_commit;
 
+    /** The time of the last frame done event, in microseconds of CLOCK_MONOTONIC. */
+    int64_t last_frame_done_us = 0;
+    /** Sends frame done events which were suppressed by a frame rate cap. */
+    wf::wl_timer<false> suppressed_frame_done;
+    bool suppress_frame_done(int64_t now_us);
+    void release_frame_callbacks(int64_t now_us);
+
     const bool autocommit;
     surface_state_t current_state;
     void apply_current_surface_state();
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <wayfire/view.hpp>
+#include <wayfire/signal-provider.hpp>
+#include <unordered_map>
+#include <vector>
+#include <string>
+
+namespace wf
+{
+class workspace_set_t;
+
+/**
+ * The view registry keeps indexes of the mapped views by their commonly queried properties, so that plugins
+ * can find the views they are interested in without filtering the list of all views.
+ *
+ * The indexes are updated from the core view signals (map, unmap, output, workspace set and app-id changes).
+ * All lookups return references to the registry's own containers, which stay valid until the next view is
+ * mapped or unmapped, or changes one of the indexed properties. Callers which may trigger such changes while
+ * iterating should copy the result first.
+ *
+ * The order of views in the results is the order in which they were mapped.
+ */
+class view_registry_t
+{
+  public:
+    view_registry_t();
+    ~view_registry_t();
+
+    /**
+     * @return All views which exist, mapped or not. Same as tracking_allocator_t<view_interface_t>::get_all(),
+     *   but without copying the list like compositor_core_t::get_all_views().
+     */
+    const std::vector<wayfire_view>& get_all_views() const;
+
+    /** @return All mapped views. */
+    const std::vector<wayfire_view>& get_mapped_views() const;
+
+    /**
+     * Find a view (mapped or not) by its id.
+     * Mapped views are found with a single lookup, unmapped views need a search through all views.
+     *
+     * @return The view with the given id, or nullptr if there is no such view.
+     */
+    wayfire_view find_view_by_id(uint32_t id) const;
+
+    /** @return The mapped views with the given app-id. */
+    const std::vector<wayfire_view>& get_views_by_app_id(const std::string& app_id) const;
+
+    /** @return The mapped views on the given output. */
+    const std::vector<wayfire_view>& get_views_on_output(wf::output_t *output) const;
+
+    /** @return The mapped toplevel views in the given workspace set. */
+    const std::vector<wayfire_view>& get_views_in_wset(wf::workspace_set_t *wset) const;
+
+    /** @return The mapped views with the given role. */
+    const std::vector<wayfire_view>& get_views_by_role(view_role_t role) const;
+
+    /**
+     * Update the indexes of a view whose properties changed without a corresponding core signal (for example
+     * the view role). No-op if the view is not mapped.
+     */
+    void update_view(wayfire_view view);
+
+  private:
+    struct impl;
+    std::unique_ptr<impl> priv;
+};
+}
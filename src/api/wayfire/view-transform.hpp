@@ -42,17 +42,46 @@ class opaque_region_node_t
     }
 };
 
+/**
+ * Counters for the ways transformers obtain the contents of their children.
+ */
+struct transformer_texture_stats_t
+{
+    // How many times the children were sampled directly, without an intermediate copy.
+    uint64_t zero_copy = 0;
+    // How many times the children had to be rendered to an auxilliary buffer.
+    uint64_t aux_buffer = 0;
+    // How many of the aux_buffer cases could reuse the buffer without a render pass.
+    uint64_t aux_buffer_reused = 0;
+};
+
+/**
+ * Get the global transformer texture statistics.
+ */
+transformer_texture_stats_t& get_transformer_texture_stats();
+
 /**
  * A base class for all transformer nodes.
  * It facilitates the reuse of auxilliary buffers between render instances.
+ *
+ * By default, transformers do not support zero-copy texturing, since they change the contents of their
+ * children. Transformers which only change the position and size of the children (and not how their
+ * pixels look) may override to_texture() to forward the children's texture instead.
  */
-class transformer_base_node_t : public scene::floating_inner_node_t
+class transformer_base_node_t : public scene::floating_inner_node_t, public zero_copy_texturable_node_t
 {
   public:
     using floating_inner_node_t::floating_inner_node_t;
 
     uint32_t optimize_update(uint32_t flags) override;
 
+    /**
+     * Get a texture of the node's only child without copying. This succeeds if the child is a single
+     * surface without subsurfaces, or a chain of transformers which all support zero-copy texturing and end
+     * with such a surface.
+     */
+    std::optional<wf::texture_t> get_children_zero_copy_texture() const;
+
     // A temporary buffer to render children to.
     wf::auxilliary_buffer_t inner_content;
 
@@ -90,16 +119,7 @@ class transformer_render_instance_t : public render_instance_t
   protected:
     std::optional<wf::texture_t> zero_copy_texture()
     {
-        if (self->get_children().size() == 1)
-        {
-            auto child = self->get_children().front().get();
-            if (auto zcopy = dynamic_cast<zero_copy_texturable_node_t*>(child))
-            {
-                return zcopy->to_texture();
-            }
-        }
-
-        return {};
+        return self->get_children_zero_copy_texture();
     }
 
     // A pointer to the transformer node this render instance belongs to.
@@ -127,10 +147,12 @@ class transformer_render_instance_t : public render_instance_t
         // pass.
         if (auto tex = zero_copy_texture())
         {
+            get_transformer_texture_stats().zero_copy++;
             self->release_buffers();
             return *tex;
         }
 
+        get_transformer_texture_stats().aux_buffer++;
         return self->get_updated_contents(self->get_children_bounding_box(), scale, children);
     }
 
@@ -311,6 +333,13 @@ class transform_manager_node_t : public wf::scene::floating_inner_node_t
         return "view-transform-root";
     }
 
+    /**
+     * The input of the view is inside its bounding box as long as it is transformed only by 2D transformers.
+     * Other transformers (for example 3D or mesh deformations) may map input arbitrarily, so no bounds are
+     * given for them.
+     */
+    std::optional<wf::geometry_t> get_input_bounds() override;
+
   private:
     struct added_transformer_t
     {
@@ -381,6 +410,15 @@ class view_2d_transformer_t : public transformer_base_node_t
     }
 
     view_2d_transformer_t(wayfire_view view);
+
+    /**
+     * A 2D transformer without rotation and with full opacity displays the children's texture as-is, just
+     * stretched to its bounding box. In this case, the children's texture can be used directly by the
+     * transformers above it.
+     *
+     * Subclasses which render differently than view_2d_transformer_t need to override this.
+     */
+    std::optional<wf::texture_t> to_texture() const override;
     wf::pointf_t to_local(const wf::pointf_t& point) override;
     wf::pointf_t to_global(const wf::pointf_t& point) override;
     std::string stringify() const override;
@@ -161,8 +161,12 @@ class view_interface_t : public wf::signal::provider_t, public wf::object_base_t
 
     /**
      * A snapshot of the view is a copy of the view's contents into a framebuffer.
+     *
+     * @param scale The resolution of the snapshot relative to the view's output.
+     * @param hints Hints for the format of the snapshot buffer.
      */
-    virtual void take_snapshot(wf::auxilliary_buffer_t& buffer);
+    virtual void take_snapshot(wf::auxilliary_buffer_t& buffer, float scale = 1.0,
+        wf::buffer_allocation_hints_t hints = {});
 
     /**
      * @return the wl_client associated with this surface, or null if the
@@ -9,6 +9,7 @@
 #include <wayfire/workarea.hpp>
 #include "wayfire/scene-operations.hpp"
 #include "wayfire/txn/transaction-manager.hpp"
+#include "wayfire/view-registry.hpp"
 #include "wayfire/bindings-repository.hpp"
 #include "wayfire/util.hpp"
 #include <memory>
@@ -97,9 +98,10 @@ bool wf::compositor_core_t::is_pixman() const
 
 void wf::compositor_core_impl_t::init()
 {
-    this->scene_root = std::make_shared<scene::root_node_t>();
-    this->tx_manager = std::make_unique<txn::transaction_manager_t>();
-    this->default_wm = std::make_unique<wf::window_manager_t>();
+    this->scene_root    = std::make_shared<scene::root_node_t>();
+    this->tx_manager    = std::make_unique<txn::transaction_manager_t>();
+    this->default_wm    = std::make_unique<wf::window_manager_t>();
+    this->view_registry = std::make_unique<wf::view_registry_t>();
 
     wlr_renderer_init_wl_display(renderer, display);
 
@@ -354,6 +356,7 @@ void wf::compositor_core_impl_t::fini()
     input.reset();
     output_layout.reset();
     tx_manager.reset();
+    view_registry.reset();
     OpenGL::fini();
     disconnect_signals();
     wl_display_destroy(static_core->display);
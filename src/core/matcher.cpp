@@ -5,6 +5,73 @@
 #include <wayfire/condition/condition.hpp>
 #include <wayfire/view-access-interface.hpp>
 #include <wayfire/parser/condition_parser.hpp>
+#include <wayfire/signal-definitions.hpp>
+#include <wayfire/toplevel-view.hpp>
+#include <wayfire/core.hpp>
+#include <unordered_map>
+
+namespace
+{
+/**
+ * The view properties a condition can depend on, grouped by the signal which announces their changes.
+ */
+enum matcher_dependency_t : uint32_t
+{
+    // Does not change while the view is mapped.
+    DEP_STATIC    = 0,
+    DEP_APP_ID    = (1 << 0),
+    DEP_TITLE     = (1 << 1),
+    DEP_MINIMIZED = (1 << 2),
+    DEP_ACTIVATED = (1 << 3),
+    // Changes without a signal, the result cannot be cached.
+    DEP_UNTRACKED = (1u << 31),
+    DEP_ALL       = ~0u,
+};
+
+uint32_t get_dependency(const std::string& identifier, wayfire_view view)
+{
+    static const std::unordered_map<std::string, uint32_t> dependencies = {
+        {"app_id", DEP_APP_ID},
+        {"title", DEP_TITLE},
+        {"role", DEP_STATIC},
+        {"mapped", DEP_STATIC},
+        {"activated", DEP_ACTIVATED},
+        {"minimized", DEP_MINIMIZED},
+        // fullscreen, maximized, floating and tiled-* are read from the pending state, which changes without
+        // a signal (view_fullscreen_signal and view_tiled_signal announce the committed state), so they are
+        // left untracked.
+    };
+
+    // The type of other views depends on their output and layer.
+    if (identifier == "type")
+    {
+        return (view->role == wf::VIEW_ROLE_TOPLEVEL) ? DEP_STATIC : DEP_UNTRACKED;
+    }
+
+    auto it = dependencies.find(identifier);
+    return (it == dependencies.end()) ? DEP_UNTRACKED : it->second;
+}
+
+/**
+ * Records the properties which a condition looks up while it is evaluated.
+ */
+class recording_access_interface_t : public wf::access_interface_t
+{
+  public:
+    recording_access_interface_t(wayfire_view view) : view(view), source(view)
+    {}
+
+    wf::variant_t get(const std::string & identifier, bool & error) override
+    {
+        dependencies |= get_dependency(identifier, view);
+        return source.get(identifier, error);
+    }
+
+    wayfire_view view;
+    wf::view_access_interface_t source;
+    uint32_t dependencies = 0;
+};
+}
 
 class wf::view_matcher_t::impl
 {
@@ -32,8 +99,108 @@ class wf::view_matcher_t::impl
         return false;
     }
 
+    /** The result of the condition for a mapped view, and the properties it depends on. */
+    struct cached_result_t
+    {
+        bool result;
+        uint32_t dependencies;
+    };
+
+    std::unordered_map<wf::view_interface_t*, cached_result_t> cache;
+
+    void clear_cache()
+    {
+        for (auto& [view, entry] : cache)
+        {
+            disconnect_view(view);
+        }
+
+        cache.clear();
+    }
+
+    /** Drop the cached result for the view if it depends on the given properties, or always for DEP_ALL. */
+    void invalidate(wf::view_interface_t *view, uint32_t dependency)
+    {
+        auto it = cache.find(view);
+        if ((it != cache.end()) && ((dependency == DEP_ALL) || (it->second.dependencies & dependency)))
+        {
+            disconnect_view(view);
+            cache.erase(it);
+        }
+    }
+
+    bool matches(wayfire_view view)
+    {
+        auto it = cache.find(view.get());
+        if (it != cache.end())
+        {
+            return it->second.result;
+        }
+
+        bool ignored = false;
+        recording_access_interface_t access_interface{view};
+        bool result = condition->evaluate(access_interface, ignored);
+
+        // Unmapped views are not cached, as there is no signal when they are destroyed.
+        if (view->is_mapped() && !(access_interface.dependencies & DEP_UNTRACKED))
+        {
+            cache[view.get()] = {result, access_interface.dependencies};
+            connect_view(view.get());
+        }
+
+        return result;
+    }
+
+    void connect_view(wf::view_interface_t *view)
+    {
+        if (!on_view_unmapped.is_connected())
+        {
+            wf::get_core().connect(&on_view_unmapped);
+            wf::get_core().connect(&on_title_changed);
+            wf::get_core().connect(&on_app_id_changed);
+        }
+
+        view->connect(&on_minimized);
+        view->connect(&on_activated);
+    }
+
+    void disconnect_view(wf::view_interface_t *view)
+    {
+        view->disconnect(&on_minimized);
+        view->disconnect(&on_activated);
+    }
+
+    wf::signal::connection_t<wf::view_unmapped_signal> on_view_unmapped = [=] (wf::view_unmapped_signal *ev)
+    {
+        invalidate(ev->view.get(), DEP_ALL);
+    };
+
+    wf::signal::connection_t<wf::view_title_changed_signal> on_title_changed =
+        [=] (wf::view_title_changed_signal *ev)
+    {
+        invalidate(ev->view.get(), DEP_TITLE);
+    };
+
+    wf::signal::connection_t<wf::view_app_id_changed_signal> on_app_id_changed =
+        [=] (wf::view_app_id_changed_signal *ev)
+    {
+        invalidate(ev->view.get(), DEP_APP_ID);
+    };
+
+    wf::signal::connection_t<wf::view_minimized_signal> on_minimized = [=] (wf::view_minimized_signal *ev)
+    {
+        invalidate(ev->view.get(), DEP_MINIMIZED);
+    };
+
+    wf::signal::connection_t<wf::view_activated_state_signal> on_activated =
+        [=] (wf::view_activated_state_signal *ev)
+    {
+        invalidate(ev->view.get(), DEP_ACTIVATED);
+    };
+
     wf::config::option_base_t::updated_callback_t update_condition = [=] ()
     {
+        clear_cache();
         if (!try_parse(option->get_value(), option->get_name()))
         {
             if (option->get_value() != option->get_default_value())
@@ -63,6 +230,7 @@ class wf::view_matcher_t::impl
     void set_option(std::shared_ptr<wf::config::option_t<std::string>> option)
     {
         disconnect_updated_handler();
+        clear_cache();
         this->option = option;
         if (option)
         {
@@ -112,10 +280,7 @@ bool wf::view_matcher_t::matches(wayfire_view view)
 {
     if (this->priv->condition)
     {
-        bool ignored = false;
-        wf::view_access_interface_t access_interface{view};
-
-        return this->priv->condition->evaluate(access_interface, ignored);
+        return this->priv->matches(view);
     }
 
     return false;
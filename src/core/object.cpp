@@ -1,11 +1,13 @@
 #include "wayfire/object.hpp"
 #include <unordered_map>
 #include <wayfire/signal-provider.hpp>
-#include <wayfire/nonstd/safe-list.hpp>
+#include <algorithm>
 
 struct wf::signal::provider_t::impl
 {
-    std::unordered_map<std::type_index, wf::safe_list_t<connection_base_t*>> typed_connections;
+    // Providers usually have connections for only a few signal types, so a linear search is faster than
+    // hashing the type name on every emit.
+    std::vector<std::pair<std::type_index, std::unique_ptr<detail::connection_list_t>>> typed_connections;
 };
 
 wf::signal::provider_t::provider_t()
@@ -15,9 +17,15 @@ wf::signal::provider_t::provider_t()
 
 wf::signal::provider_t::~provider_t()
 {
-    for (auto& [id, connected] : priv->typed_connections)
+    for (auto& [id, list] : priv->typed_connections)
     {
-        connected.for_each([&] (connection_base_t *base) { disconnect_other_side(base); });
+        for (auto& connection : list->connections)
+        {
+            if (connection)
+            {
+                disconnect_other_side(connection);
+            }
+        }
     }
 }
 
@@ -29,14 +37,46 @@ void wf::signal::provider_t::disconnect_other_side(connection_base_t *callback)
 
 void wf::signal::provider_t::connect_base(std::type_index idx, connection_base_t *callback)
 {
-    priv->typed_connections[idx].push_back(callback);
+    auto list = find_connections(idx);
+    if (!list)
+    {
+        priv->typed_connections.emplace_back(idx, std::make_unique<detail::connection_list_t>());
+        list = priv->typed_connections.back().second.get();
+    }
+
+    list->connections.push_back(callback);
     callback->connected_to.push_back(this);
 }
 
-void wf::signal::provider_t::for_each_connection(
-    std::type_index type, std::function<void(connection_base_t*)> func)
+wf::signal::detail::connection_list_t*wf::signal::provider_t::find_connections(std::type_index type)
 {
-    priv->typed_connections[type].for_each(func);
+    // Fast path: the type_info objects are the same if the signal is emitted from the same binary which
+    // connected to it, so comparing the names by pointer suffices.
+    for (auto& [id, list] : priv->typed_connections)
+    {
+        if (id.name() == type.name())
+        {
+            return list.get();
+        }
+    }
+
+    // Plugins are loaded with RTLD_LOCAL, so they may have their own copies of the type_info.
+    for (auto& [id, list] : priv->typed_connections)
+    {
+        if (id == type)
+        {
+            return list.get();
+        }
+    }
+
+    return nullptr;
+}
+
+void wf::signal::provider_t::compact(detail::connection_list_t *list)
+{
+    auto it = std::remove(list->connections.begin(), list->connections.end(), nullptr);
+    list->connections.erase(it, list->connections.end());
+    list->has_removed = false;
 }
 
 void wf::signal::connection_base_t::disconnect()
@@ -51,19 +91,55 @@ void wf::signal::connection_base_t::disconnect()
 void wf::signal::provider_t::disconnect(connection_base_t *callback)
 {
     disconnect_other_side(callback);
-    for (auto& [id, connected] : priv->typed_connections)
+    for (auto& [id, list] : priv->typed_connections)
     {
-        connected.remove_all(callback);
+        if (list->emitting)
+        {
+            // Do not invalidate the indices of an ongoing emission, the list is compacted afterwards.
+            std::replace(list->connections.begin(), list->connections.end(), callback,
+                (connection_base_t*)nullptr);
+            list->has_removed = true;
+        } else
+        {
+            auto it = std::remove(list->connections.begin(), list->connections.end(), callback);
+            list->connections.erase(it, list->connections.end());
+        }
     }
 }
 
 class wf::object_base_t::obase_impl
 {
   public:
-    std::unordered_map<std::string, std::unique_ptr<custom_data_t>> data;
+    // Objects usually have only a few pieces of data, so a flat list is the fastest to search.
+    std::vector<std::pair<uint32_t, std::unique_ptr<custom_data_t>>> data;
     uint32_t object_id;
+
+    auto find(uint32_t slot)
+    {
+        return std::find_if(data.begin(), data.end(), [=] (const auto& entry) { return entry.first == slot; });
+    }
 };
 
+static std::unordered_map<std::string, uint32_t>& get_slot_registry()
+{
+    static std::unordered_map<std::string, uint32_t> registry;
+    return registry;
+}
+
+uint32_t wf::object_base_t::_register_slot(const std::string& name)
+{
+    auto& registry = get_slot_registry();
+    auto [it, _] = registry.try_emplace(name, registry.size());
+    return it->second;
+}
+
+uint32_t wf::object_base_t::_find_slot(const std::string& name)
+{
+    auto& registry = get_slot_registry();
+    auto it = registry.find(name);
+    return (it == registry.end()) ? INVALID_SLOT : it->second;
+}
+
 wf::object_base_t::object_base_t()
 {
     this->obase_priv = std::make_unique<obase_impl>();
@@ -86,24 +162,24 @@ uint32_t wf::object_base_t::get_id() const
 
 bool wf::object_base_t::has_data(std::string name)
 {
-    return _fetch_data(name) != nullptr;
+    return _fetch_data(_find_slot(name)) != nullptr;
 }
 
 void wf::object_base_t::erase_data(std::string name)
 {
-    if (!has_data(name))
-    {
-        return;
-    }
+    _erase_data(_find_slot(name));
+}
 
-    auto data = std::move(obase_priv->data[name]);
-    obase_priv->data.erase(name);
+void wf::object_base_t::_erase_data(uint32_t slot)
+{
+    // Remove the entry before destroying the data, as the destructor may access the object's data.
+    std::unique_ptr<custom_data_t> data{_fetch_erase(slot)};
     data.reset();
 }
 
-wf::custom_data_t*wf::object_base_t::_fetch_data(std::string name)
+wf::custom_data_t*wf::object_base_t::_fetch_data(uint32_t slot)
 {
-    auto it = obase_priv->data.find(name);
+    auto it = obase_priv->find(slot);
     if (it == obase_priv->data.end())
     {
         return nullptr;
@@ -112,30 +188,39 @@ wf::custom_data_t*wf::object_base_t::_fetch_data(std::string name)
     return it->second.get();
 }
 
-wf::custom_data_t*wf::object_base_t::_fetch_erase(std::string name)
+wf::custom_data_t*wf::object_base_t::_fetch_erase(uint32_t slot)
 {
-    auto data = obase_priv->data[name].release();
-    erase_data(name);
+    auto it = obase_priv->find(slot);
+    if (it == obase_priv->data.end())
+    {
+        return nullptr;
+    }
 
+    auto data = it->second.release();
+    obase_priv->data.erase(it);
     return data;
 }
 
-void wf::object_base_t::_store_data(std::unique_ptr<wf::custom_data_t> data,
-    std::string name)
+void wf::object_base_t::_store_data(std::unique_ptr<wf::custom_data_t> data, uint32_t slot)
 {
-    obase_priv->data[name] = std::move(data);
+    auto it = obase_priv->find(slot);
+    if (it == obase_priv->data.end())
+    {
+        obase_priv->data.emplace_back(slot, std::move(data));
+        return;
+    }
+
+    // Destroy the old data only after the new data is in place.
+    std::swap(it->second, data);
+    data.reset();
 }
 
 void wf::object_base_t::_clear_data()
 {
-    std::vector<std::string> keys;
-    for (auto const& [key, val] : obase_priv->data)
-    {
-        keys.push_back(key);
-    }
-
-    for (const auto& key : keys)
+    while (!obase_priv->data.empty())
     {
-        erase_data(key);
+        auto data = std::move(obase_priv->data.back().second);
+        obase_priv->data.pop_back();
+        data.reset();
     }
 }
@@ -70,6 +70,24 @@ std::string node_t::stringify_flags() const
     return "(" + fl + ")";
 }
 
+static uint64_t input_bounds_serial = 1;
+
+void invalidate_input_bounds()
+{
+    ++input_bounds_serial;
+}
+
+const std::optional<wf::geometry_t>& node_t::get_cached_input_bounds()
+{
+    if (cached_input_bounds_serial != input_bounds_serial)
+    {
+        cached_input_bounds = get_input_bounds();
+        cached_input_bounds_serial = input_bounds_serial;
+    }
+
+    return cached_input_bounds;
+}
+
 std::optional<input_node_t> node_t::find_node_at(const wf::pointf_t& at)
 {
     auto local = this->to_local(at);
@@ -80,6 +98,12 @@ std::optional<input_node_t> node_t::find_node_at(const wf::pointf_t& at)
             continue;
         }
 
+        auto& bounds = node->get_cached_input_bounds();
+        if (bounds && !(*bounds & local))
+        {
+            continue;
+        }
+
         auto child_node = node->find_node_at(local);
         if (child_node.has_value())
         {
@@ -491,6 +515,7 @@ void set_node_enabled(wf::scene::node_ptr node, bool enabled)
 
 void update(node_ptr changed_node, uint32_t flags)
 {
+    invalidate_input_bounds();
     if ((flags & update_flag::CHILDREN_LIST) ||
         (flags & update_flag::ENABLED) ||
         (flags & update_flag::GEOMETRY))
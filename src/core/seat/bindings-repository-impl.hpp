@@ -4,9 +4,148 @@
 #include "hotspot-manager.hpp"
 #include "wayfire/signal-definitions.hpp"
 #include <wayfire/debug.hpp>
+#include <unordered_map>
 
 struct wf::bindings_repository_t::impl
 {
+    using key_binding_t = binding_t<wf::keybinding_t, key_callback>;
+    using axis_binding_t = binding_t<wf::keybinding_t, axis_callback>;
+    using button_binding_t = binding_t<wf::buttonbinding_t, button_callback>;
+    using activator_binding_t = binding_t<wf::activatorbinding_t, activator_callback>;
+
+    /**
+     * The bindings which match a given combination of modifiers and key or button.
+     * Key and button bindings come first, activators are triggered after them, in registration order.
+     */
+    template<class Binding>
+    struct index_entry_t
+    {
+        std::vector<Binding*> bindings;
+        std::vector<activator_binding_t*> activators;
+    };
+
+    /**
+     * Indexes from (modifiers, key/button) to the matching bindings. The entries are filled on the first
+     * event with a given combination and dropped whenever a binding is added, removed or its option changes.
+     */
+    std::unordered_map<uint64_t, index_entry_t<key_binding_t>> key_index;
+    std::unordered_map<uint64_t, index_entry_t<button_binding_t>> button_index;
+    std::unordered_map<uint32_t, std::vector<axis_binding_t*>> axis_index;
+
+    binding_lookup_stats_t lookup_stats;
+
+    static uint64_t index_key(uint32_t modifiers, uint32_t code)
+    {
+        return ((uint64_t)modifiers << 32) | code;
+    }
+
+    void invalidate_index()
+    {
+        key_index.clear();
+        button_index.clear();
+        axis_index.clear();
+    }
+
+    /**
+     * Find the index entry for the given binding, or build it with a scan of all bindings of the same type
+     * and of all activators.
+     */
+    template<class Binding, class Pressed>
+    const index_entry_t<Binding>& lookup(std::unordered_map<uint64_t, index_entry_t<Binding>>& index,
+        const std::vector<std::unique_ptr<Binding>>& bindings, uint64_t key, const Pressed& pressed)
+    {
+        ++lookup_stats.lookups;
+        auto it = index.find(key);
+        if (it != index.end())
+        {
+            ++lookup_stats.index_hits;
+            return it->second;
+        }
+
+        index_entry_t<Binding> entry;
+        for (auto& binding : bindings)
+        {
+            if (binding->activated_by->get_value() == pressed)
+            {
+                entry.bindings.push_back(binding.get());
+            }
+        }
+
+        for (auto& binding : activators)
+        {
+            if (binding->activated_by->get_value().has_match(pressed))
+            {
+                entry.activators.push_back(binding.get());
+            }
+        }
+
+        lookup_stats.comparisons += bindings.size() + activators.size();
+        return index.emplace(key, std::move(entry)).first->second;
+    }
+
+    const std::vector<axis_binding_t*>& lookup_axis(uint32_t modifiers)
+    {
+        ++lookup_stats.lookups;
+        auto it = axis_index.find(modifiers);
+        if (it != axis_index.end())
+        {
+            ++lookup_stats.index_hits;
+            return it->second;
+        }
+
+        std::vector<axis_binding_t*> entry;
+        for (auto& binding : axes)
+        {
+            if (binding->activated_by->get_value() == wf::keybinding_t{modifiers, 0})
+            {
+                entry.push_back(binding.get());
+            }
+        }
+
+        lookup_stats.comparisons += axes.size();
+        return axis_index.emplace(modifiers, std::move(entry)).first->second;
+    }
+
+    /**
+     * Options are often shared between bindings (for example per-output plugins register the same option
+     * once per output), so the updated handler is connected once per option.
+     */
+    std::unordered_map<wf::config::option_base_t*,
+        std::pair<std::shared_ptr<wf::config::option_base_t>, int>> watched_options;
+
+    wf::config::option_base_t::updated_callback_t on_binding_option_updated = [=] ()
+    {
+        invalidate_index();
+    };
+
+    void watch_option(std::shared_ptr<wf::config::option_base_t> option)
+    {
+        auto& watched = watched_options[option.get()];
+        if (watched.second++ == 0)
+        {
+            watched.first = option;
+            option->add_updated_handler(&on_binding_option_updated);
+        }
+    }
+
+    void unwatch_option(wf::config::option_base_t *option)
+    {
+        auto it = watched_options.find(option);
+        if ((it != watched_options.end()) && (--it->second.second == 0))
+        {
+            option->rem_updated_handler(&on_binding_option_updated);
+            watched_options.erase(it);
+        }
+    }
+
+    ~impl()
+    {
+        for (auto& [option, watched] : watched_options)
+        {
+            option->rem_updated_handler(&on_binding_option_updated);
+        }
+    }
+
     /**
      * Recreate hotspots.
      *
@@ -37,6 +176,7 @@ struct wf::bindings_repository_t::impl
 
     wf::signal::connection_t<wf::reload_config_signal> on_config_reload = [=] (wf::reload_config_signal *ev)
     {
+        invalidate_index();
         recreate_hotspots();
         reparse_extensions();
     };
@@ -9,13 +9,15 @@ wf::bindings_repository_t::bindings_repository_t()
 }
 
 template<class Option, class Callback>
-static void push_binding(wf::binding_container_t<Option, Callback>& bindings,
-    wf::option_sptr_t<Option> opt, Callback *callback)
+static void push_binding(wf::bindings_repository_t::impl *priv,
+    wf::binding_container_t<Option, Callback>& bindings, wf::option_sptr_t<Option> opt, Callback *callback)
 {
     auto bnd = std::make_unique<wf::binding_t<Option, Callback>>();
     bnd->activated_by = opt;
     bnd->callback     = callback;
     bindings.emplace_back(std::move(bnd));
+    priv->watch_option(opt);
+    priv->invalidate_index();
 }
 
 wf::bindings_repository_t::~bindings_repository_t()
@@ -23,23 +25,23 @@ wf::bindings_repository_t::~bindings_repository_t()
 
 void wf::bindings_repository_t::add_key(option_sptr_t<keybinding_t> key, wf::key_callback *cb)
 {
-    push_binding(priv->keys, key, cb);
+    push_binding(priv.get(), priv->keys, key, cb);
 }
 
 void wf::bindings_repository_t::add_axis(option_sptr_t<keybinding_t> axis, wf::axis_callback *cb)
 {
-    push_binding(priv->axes, axis, cb);
+    push_binding(priv.get(), priv->axes, axis, cb);
 }
 
 void wf::bindings_repository_t::add_button(option_sptr_t<buttonbinding_t> button, wf::button_callback *cb)
 {
-    push_binding(priv->buttons, button, cb);
+    push_binding(priv.get(), priv->buttons, button, cb);
 }
 
 void wf::bindings_repository_t::add_activator(
     option_sptr_t<activatorbinding_t> activator, wf::activator_callback *cb)
 {
-    push_binding(priv->activators, activator, cb);
+    push_binding(priv.get(), priv->activators, activator, cb);
     if (activator->get_value().get_hotspots().size())
     {
         priv->recreate_hotspots();
@@ -54,44 +56,41 @@ bool wf::bindings_repository_t::handle_key(const wf::keybinding_t& pressed,
         return false;
     }
 
+    auto& entry = priv->lookup(priv->key_index, priv->keys,
+        impl::index_key(pressed.get_modifiers(), pressed.get_key()), pressed);
+
     std::vector<std::function<bool()>> callbacks;
-    for (auto& binding : this->priv->keys)
+    for (auto& binding : entry.bindings)
     {
-        if (binding->activated_by->get_value() == pressed)
+        /* We must be careful because the callback might be erased,
+         * so force copy the callback into the lambda */
+        auto callback = binding->callback;
+        callbacks.emplace_back([pressed, callback] ()
         {
-            /* We must be careful because the callback might be erased,
-             * so force copy the callback into the lambda */
-            auto callback = binding->callback;
-            callbacks.emplace_back([pressed, callback] ()
-            {
-                return (*callback)(pressed);
-            });
-        }
+            return (*callback)(pressed);
+        });
     }
 
-    for (auto& binding : this->priv->activators)
+    for (auto& binding : entry.activators)
     {
-        if (binding->activated_by->get_value().has_match(pressed))
+        /* We must be careful because the callback might be erased,
+         * so force copy the callback into the lambda */
+        auto callback = binding->callback;
+        callbacks.emplace_back([pressed, callback, mod_binding_key] ()
         {
-            /* We must be careful because the callback might be erased,
-             * so force copy the callback into the lambda */
-            auto callback = binding->callback;
-            callbacks.emplace_back([pressed, callback, mod_binding_key] ()
-            {
-                wf::activator_data_t ev = {
-                    .source = activator_source_t::KEYBINDING,
-                    .activation_data = pressed.get_key()
-                };
+            wf::activator_data_t ev = {
+                .source = activator_source_t::KEYBINDING,
+                .activation_data = pressed.get_key()
+            };
 
-                if (mod_binding_key)
-                {
-                    ev.source = activator_source_t::MODIFIERBINDING;
-                    ev.activation_data = mod_binding_key;
-                }
+            if (mod_binding_key)
+            {
+                ev.source = activator_source_t::MODIFIERBINDING;
+                ev.activation_data = mod_binding_key;
+            }
 
-                return (*callback)(ev);
-            });
-        }
+            return (*callback)(ev);
+        });
     }
 
     bool handled = false;
@@ -112,13 +111,9 @@ bool wf::bindings_repository_t::handle_axis(uint32_t modifiers,
     }
 
     std::vector<wf::axis_callback*> callbacks;
-
-    for (auto& binding : this->priv->axes)
+    for (auto& binding : priv->lookup_axis(modifiers))
     {
-        if (binding->activated_by->get_value() == wf::keybinding_t{modifiers, 0})
-        {
-            callbacks.push_back(binding->callback);
-        }
+        callbacks.push_back(binding->callback);
     }
 
     for (auto call : callbacks)
@@ -136,37 +131,34 @@ bool wf::bindings_repository_t::handle_button(const wf::buttonbinding_t& pressed
         return false;
     }
 
+    auto& entry = priv->lookup(priv->button_index, priv->buttons,
+        impl::index_key(pressed.get_modifiers(), pressed.get_button()), pressed);
+
     std::vector<std::function<bool()>> callbacks;
-    for (auto& binding : this->priv->buttons)
+    for (auto& binding : entry.bindings)
     {
-        if (binding->activated_by->get_value() == pressed)
+        /* We must be careful because the callback might be erased,
+         * so force copy the callback into the lambda */
+        auto callback = binding->callback;
+        callbacks.emplace_back([=] ()
         {
-            /* We must be careful because the callback might be erased,
-             * so force copy the callback into the lambda */
-            auto callback = binding->callback;
-            callbacks.emplace_back([=] ()
-            {
-                return (*callback)(pressed);
-            });
-        }
+            return (*callback)(pressed);
+        });
     }
 
-    for (auto& binding : this->priv->activators)
+    for (auto& binding : entry.activators)
     {
-        if (binding->activated_by->get_value().has_match(pressed))
+        /* We must be careful because the callback might be erased,
+         * so force copy the callback into the lambda */
+        auto callback = binding->callback;
+        callbacks.emplace_back([=] ()
         {
-            /* We must be careful because the callback might be erased,
-             * so force copy the callback into the lambda */
-            auto callback = binding->callback;
-            callbacks.emplace_back([=] ()
-            {
-                wf::activator_data_t data = {
-                    .source = activator_source_t::BUTTONBINDING,
-                    .activation_data = pressed.get_button(),
-                };
-                return (*callback)(data);
-            });
-        }
+            wf::activator_data_t data = {
+                .source = activator_source_t::BUTTONBINDING,
+                .activation_data = pressed.get_button(),
+            };
+            return (*callback)(data);
+        });
     }
 
     bool binding_handled = false;
@@ -242,8 +234,16 @@ bool wf::bindings_repository_t::handle_extension_generic(
 
 void wf::bindings_repository_t::rem_binding(void *callback)
 {
-    const auto& erase = [callback] (auto& container)
+    const auto& erase = [this, callback] (auto& container)
     {
+        for (auto& ptr : container)
+        {
+            if (ptr->callback == callback)
+            {
+                priv->unwatch_option(ptr->activated_by.get());
+            }
+        }
+
         auto it = std::remove_if(container.begin(), container.end(),
             [callback] (const auto& ptr)
         {
@@ -262,6 +262,7 @@ void wf::bindings_repository_t::rem_binding(void *callback)
     erase(priv->buttons);
     erase(priv->axes);
     erase(priv->activators);
+    priv->invalidate_index();
 
     if (update_hotspots)
     {
@@ -310,3 +311,13 @@ void wf::bindings_repository_t::reparse_extensions()
 {
     priv->reparse_extensions();
 }
+
+wf::binding_lookup_stats_t wf::bindings_repository_t::get_lookup_stats() const
+{
+    return priv->lookup_stats;
+}
+
+void wf::bindings_repository_t::reset_lookup_stats()
+{
+    priv->lookup_stats = {};
+}
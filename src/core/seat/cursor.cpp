@@ -50,9 +50,36 @@ void wf::cursor_t::setup_listeners()
     });
     on_frame.connect(&cursor->events.frame);
 
+    on_motion.set_callback([&] (void *data)
+    {
+        set_touchscreen_mode(false);
+        auto ev   = static_cast<wlr_pointer_motion_event*>(data);
+        auto mode = emit_device_event_signal(ev, &ev->pointer->base);
+        if (mode != wf::input_event_processing_mode_t::IGNORE)
+        {
+            // Deferred motion emits the post event signal when it is processed.
+            bool deferred = seat->priv->lpointer->queue_pointer_motion(ev);
+            if (!deferred)
+            {
+                seat->priv->lpointer->handle_pointer_motion(ev, mode);
+            }
+
+            wf::get_core().seat->notify_activity();
+            if (deferred)
+            {
+                return;
+            }
+        }
+
+        emit_device_post_event_signal(ev, &ev->pointer->base);
+    });
+    on_motion.connect(&cursor->events.motion);
+
+    /* Pending relative motion is processed before any other pointer event, to keep the event order. */
 #define setup_passthrough_callback(evname) \
     on_ ## evname.set_callback([&] (void *data) { \
         set_touchscreen_mode(false); \
+        seat->priv->lpointer->flush_pointer_motion(); \
         auto ev   = static_cast<wlr_pointer_ ## evname ## _event*>(data); \
         auto mode = emit_device_event_signal(ev, &ev->pointer->base); \
         if (mode != wf::input_event_processing_mode_t::IGNORE) \
@@ -65,7 +92,6 @@ void wf::cursor_t::setup_listeners()
     on_ ## evname.connect(&cursor->events.evname);
 
     setup_passthrough_callback(button);
-    setup_passthrough_callback(motion);
     setup_passthrough_callback(motion_absolute);
     setup_passthrough_callback(axis);
     setup_passthrough_callback(swipe_begin);
@@ -85,6 +111,7 @@ void wf::cursor_t::setup_listeners()
 #define setup_tablet_callback(evname) \
     on_tablet_ ## evname.set_callback([&] (void *data) { \
         set_touchscreen_mode(false); \
+        seat->priv->lpointer->flush_pointer_motion(); \
         auto ev = static_cast<wlr_tablet_tool_ ## evname ## _event*>(data); \
         auto handling_mode = emit_device_event_signal(ev, &ev->tablet->base); \
         if (ev->tablet->data) { \
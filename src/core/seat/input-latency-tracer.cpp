@@ -0,0 +1,190 @@
+#include "input-latency-tracer.hpp"
+#include <wayfire/input-resampler.hpp>
+#include <wayfire/output.hpp>
+#include <wayfire/view.hpp>
+#include <wayfire/debug.hpp>
+#include <algorithm>
+#include <ctime>
+
+static int64_t monotonic_us()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000ll + ts.tv_nsec / 1000;
+}
+
+struct wf::input_latency_tracer_t::trace_t
+{
+    uint64_t id;
+    wlr_surface *surface;
+    wlr_output *output = nullptr;
+    uint32_t output_commit_seq = 0;
+    bool finished = false;
+
+    int64_t event_us;
+    int64_t delivered_us;
+    int64_t committed_us = 0;
+
+    wf::wl_listener_wrapper on_surface_commit, on_surface_destroy;
+    wf::wl_listener_wrapper on_output_commit, on_output_present, on_output_destroy;
+
+    void disconnect()
+    {
+        on_surface_commit.disconnect();
+        on_surface_destroy.disconnect();
+        on_output_commit.disconnect();
+        on_output_present.disconnect();
+        on_output_destroy.disconnect();
+    }
+};
+
+wf::input_latency_tracer_t::input_latency_tracer_t()
+{
+    idle_drop_finished.set_callback([=] () { drop_finished(); });
+}
+
+wf::input_latency_tracer_t::~input_latency_tracer_t() = default;
+
+void wf::input_latency_tracer_t::trace(uint32_t time_msec, wlr_surface *surface)
+{
+    if (!enabled || !surface)
+    {
+        return;
+    }
+
+    const int64_t now = monotonic_us();
+    for (auto& trace : traces)
+    {
+        if (!trace->finished && (now - trace->delivered_us > TRACE_TIMEOUT_US))
+        {
+            LOGC(INPUT_DEVICES, "Input latency trace ", trace->id, " timed out");
+            finish(trace.get(), -1);
+        }
+    }
+
+    drop_finished();
+    bool already_traced = std::any_of(traces.begin(), traces.end(), [&] (const auto& trace)
+    {
+        return trace->surface == surface;
+    });
+    if (already_traced || (traces.size() >= MAX_TRACES))
+    {
+        return;
+    }
+
+    auto trace = std::make_unique<trace_t>();
+    trace->id = next_id++;
+    trace->surface  = surface;
+    trace->event_us = std::min(wf::input_event_time_to_msec(time_msec) * 1000, now);
+    trace->delivered_us = now;
+
+    auto raw = trace.get();
+    raw->on_surface_commit.set_callback([=] (void*) { on_surface_commit(raw); });
+    raw->on_surface_commit.connect(&surface->events.commit);
+    raw->on_surface_destroy.set_callback([=] (void*) { finish(raw, -1); });
+    raw->on_surface_destroy.connect(&surface->events.destroy);
+    traces.push_back(std::move(trace));
+}
+
+void wf::input_latency_tracer_t::on_surface_commit(trace_t *trace)
+{
+    auto root = wlr_surface_get_root_surface(trace->surface);
+    auto view = wf::wl_surface_to_wayfire_view(root->resource);
+    if (!view || !view->get_output())
+    {
+        finish(trace, -1);
+        return;
+    }
+
+    trace->committed_us = monotonic_us();
+    trace->output = view->get_output()->handle;
+    trace->on_surface_commit.disconnect();
+    trace->on_surface_destroy.disconnect();
+
+    trace->on_output_commit.set_callback([=] (void *data)
+    {
+        auto ev = static_cast<wlr_output_event_commit*>(data);
+        if (ev->state->committed & WLR_OUTPUT_STATE_BUFFER)
+        {
+            on_output_commit(trace);
+        }
+    });
+    trace->on_output_commit.connect(&trace->output->events.commit);
+    trace->on_output_destroy.set_callback([=] (void*) { finish(trace, -1); });
+    trace->on_output_destroy.connect(&trace->output->events.destroy);
+}
+
+void wf::input_latency_tracer_t::on_output_commit(trace_t *trace)
+{
+    // The presentation event of this commit carries the same sequence number.
+    trace->output_commit_seq = trace->output->commit_seq;
+    trace->on_output_commit.disconnect();
+    trace->on_output_present.set_callback([=] (void *data)
+    {
+        on_output_present(trace, static_cast<wlr_output_event_present*>(data));
+    });
+    trace->on_output_present.connect(&trace->output->events.present);
+}
+
+void wf::input_latency_tracer_t::on_output_present(trace_t *trace, wlr_output_event_present *ev)
+{
+    if (ev->commit_seq < trace->output_commit_seq)
+    {
+        return;
+    }
+
+    if (!ev->presented)
+    {
+        finish(trace, -1);
+        return;
+    }
+
+    int64_t presented_us = ev->when ?
+        (ev->when->tv_sec * 1000000ll + ev->when->tv_nsec / 1000) : monotonic_us();
+    finish(trace, presented_us);
+}
+
+void wf::input_latency_tracer_t::finish(trace_t *trace, int64_t presented_us)
+{
+    trace->disconnect();
+    trace->finished = true;
+    idle_drop_finished.run_once();
+
+    if (presented_us < 0)
+    {
+        ++dropped;
+        return;
+    }
+
+    handling.add(trace->delivered_us - trace->event_us);
+    client.add(trace->committed_us - trace->delivered_us);
+    present.add(presented_us - trace->committed_us);
+    total.add(presented_us - trace->event_us);
+    LOGC(INPUT_DEVICES, "Input latency trace ", trace->id, ": ", presented_us - trace->event_us, "us");
+}
+
+void wf::input_latency_tracer_t::drop_finished()
+{
+    traces.erase(std::remove_if(traces.begin(), traces.end(),
+        [] (const auto& trace) { return trace->finished; }), traces.end());
+}
+
+wf::input_latency_stats_t wf::input_latency_tracer_t::get_stats() const
+{
+    input_latency_stats_t stats;
+    stats.handling = handling.get_percentiles();
+    stats.client   = client.get_percentiles();
+    stats.present  = present.get_percentiles();
+    stats.total    = total.get_percentiles();
+    stats.dropped  = dropped;
+    return stats;
+}
+
+void wf::input_latency_tracer_t::reset_stats()
+{
+    handling.reset();
+    client.reset();
+    present.reset();
+    total.reset();
+    dropped = 0;
+}
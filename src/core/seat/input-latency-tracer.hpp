@@ -0,0 +1,61 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <wayfire/seat.hpp>
+#include <wayfire/util.hpp>
+#include <wayfire/option-wrapper.hpp>
+#include <wayfire/nonstd/wlroots-full.hpp>
+
+namespace wf
+{
+/**
+ * Follows input events from the device until the first presented frame which can reflect them.
+ *
+ * An input event is traced after it has been sent to a client surface. The trace then waits for the next
+ * commit of that surface, the next commit of the output showing the surface, and the presentation of that
+ * output commit. At most one event per surface is traced at a time, so the measured latency is the one of
+ * the oldest event which is not yet on screen.
+ *
+ * Tracing is enabled with the input/trace_latency option.
+ */
+class input_latency_tracer_t
+{
+  public:
+    input_latency_tracer_t();
+    ~input_latency_tracer_t();
+
+    /**
+     * Start tracing an input event which was just sent to the given surface.
+     *
+     * @param time_msec The timestamp of the input event, as reported by the device.
+     */
+    void trace(uint32_t time_msec, wlr_surface *surface);
+
+    input_latency_stats_t get_stats() const;
+    void reset_stats();
+
+  private:
+    /** Maximal number of events traced at the same time. */
+    static constexpr size_t MAX_TRACES = 32;
+    /** Traces which do not reach the screen within this time (in microseconds) are dropped. */
+    static constexpr int64_t TRACE_TIMEOUT_US = 1000000;
+
+    struct trace_t;
+    std::vector<std::unique_ptr<trace_t>> traces;
+    uint64_t next_id = 0;
+
+    wf::option_wrapper_t<bool> enabled{"input/trace_latency"};
+    uint64_t dropped = 0;
+    latency_samples_t handling, client, present, total;
+
+    void on_surface_commit(trace_t *trace);
+    void on_output_commit(trace_t *trace);
+    void on_output_present(trace_t *trace, wlr_output_event_present *ev);
+    void finish(trace_t *trace, int64_t presented_us);
+
+    /** Finished traces are destroyed on idle, as they are finished from their own listeners. */
+    void drop_finished();
+    wf::wl_idle_call idle_drop_finished;
+};
+}
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "seat-impl.hpp"
+#include "keymap-cache.hpp"
 #include "wayfire/signal-provider.hpp"
 #include "wayfire/core.hpp"
 #include "wayfire/signal-definitions.hpp"
@@ -34,6 +35,9 @@ class input_manager_t
      */
     uint32_t locked_mods = 0;
 
+    /** The compiled keymaps, shared by all keyboards. */
+    keymap_cache_t keymap_cache;
+
     /**
      * Map a single input device to output as specified in the
      * config file or by hints in the wlroots backend.
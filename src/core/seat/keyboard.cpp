@@ -1,4 +1,3 @@
-#include <cstring>
 #include <wayfire/bindings-repository.hpp>
 #include <linux/input-event-codes.h>
 #include <wayland-server-protocol.h>
@@ -83,6 +82,11 @@ void wf::keyboard_t::setup_listeners()
                 LOGC(IM, "key=", ev->keycode, " state=", ev->state, " sent to node.");
                 seat->priv->keyboard_focus->keyboard_interaction()
                     .handle_keyboard_key(wf::get_core().seat.get(), *ev);
+                if (ev->state == WL_KEYBOARD_KEY_STATE_PRESSED)
+                {
+                    auto surface = seat->seat->keyboard_state.focused_surface;
+                    seat->priv->latency_tracer.trace(ev->time_msec, surface);
+                }
             }
         } else
         {
@@ -174,33 +178,44 @@ void wf::keyboard_t::reload_input_options()
 
     this->dirty_options = false;
 
-    auto ctx = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+    keymap_names_t names;
+    names.rules   = this->rules;
+    names.model   = this->model;
+    names.layout  = this->layout;
+    names.variant = this->variant;
+    names.options = this->options;
+
+    wlr_keyboard_set_repeat_info(handle, repeat_rate, repeat_delay);
 
-    /* Copy memory to stack, so that .c_str() is valid */
-    std::string rules   = this->rules;
-    std::string model   = this->model;
-    std::string layout  = this->layout;
-    std::string variant = this->variant;
-    std::string options = this->options;
+    auto& cache = wf::get_core_impl().input->keymap_cache;
+    uint64_t serial = ++(*keymap_request);
+    if (!handle->keymap)
+    {
+        // A new keyboard cannot be used until it has a keymap.
+        apply_keymap(cache.get_keymap(names));
+        return;
+    }
 
-    xkb_rule_names names;
-    names.rules   = rules.c_str();
-    names.model   = model.c_str();
-    names.layout  = layout.c_str();
-    names.variant = variant.c_str();
-    names.options = options.c_str();
-    auto keymap = xkb_map_new_from_names(ctx, &names,
-        XKB_KEYMAP_COMPILE_NO_FLAGS);
+    // Keep the old keymap until the new one is compiled.
+    std::weak_ptr<uint64_t> request = keymap_request;
+    cache.request_keymap(names, [=] (xkb_keymap *keymap)
+    {
+        auto latest = request.lock();
+        if (latest && (*latest == serial))
+        {
+            apply_keymap(keymap);
+        }
+    });
+}
 
+void wf::keyboard_t::apply_keymap(xkb_keymap *keymap)
+{
     if (!keymap)
     {
-        LOGE("Could not create keymap with given configuration:",
-            " rules=\"", rules, "\" model=\"", model, "\" layout=\"", layout,
-            "\" variant=\"", variant, "\" options=\"", options, "\"");
+        LOGE("Could not create keymap with given configuration: ", keymap_names_t{rules, model, layout,
+            variant, options}.describe());
 
-        // reset to NULL
-        std::memset(&names, 0, sizeof(names));
-        keymap = xkb_map_new_from_names(ctx, &names, XKB_KEYMAP_COMPILE_NO_FLAGS);
+        keymap = wf::get_core_impl().input->keymap_cache.get_keymap({});
     }
 
     xkb_mod_mask_t locked_mods = 0;
@@ -216,11 +231,6 @@ void wf::keyboard_t::reload_input_options()
     }
 
     wlr_keyboard_set_keymap(handle, keymap);
-    xkb_keymap_unref(keymap);
-    xkb_context_unref(ctx);
-
-    wlr_keyboard_set_repeat_info(handle, repeat_rate, repeat_delay);
-
     wlr_keyboard_notify_modifiers(handle, 0, 0, locked_mods, 0);
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <memory>
 #include "seat-impl.hpp"
 #include "wayfire/signal-definitions.hpp"
 #include "wayfire/signal-provider.hpp"
@@ -43,6 +44,18 @@ class keyboard_t
     wf::signal::connection_t<wf::reload_config_signal> on_config_reload;
     void reload_input_options();
 
+    /**
+     * Set the keymap and re-apply the locked modifiers. Falls back to the default keymap if the keymap
+     * could not be compiled.
+     */
+    void apply_keymap(xkb_keymap *keymap);
+
+    /**
+     * The serial of the latest keymap request. Requests which are answered after a newer one was made, or
+     * after the keyboard is destroyed, are ignored.
+     */
+    std::shared_ptr<uint64_t> keymap_request = std::make_shared<uint64_t>(0);
+
     wf::option_wrapper_t<std::string> model, variant, layout, options, rules;
     wf::option_wrapper_t<int> repeat_rate, repeat_delay;
     /** Options have changed in the config file */
@@ -0,0 +1,198 @@
+#include "keymap-cache.hpp"
+#include <wayfire/core.hpp>
+#include <wayfire/debug.hpp>
+#include <wayfire/util/log.hpp>
+#include <wayland-server-core.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <chrono>
+
+std::string wf::keymap_names_t::describe() const
+{
+    return "rules=\"" + rules + "\" model=\"" + model + "\" layout=\"" + layout +
+           "\" variant=\"" + variant + "\" options=\"" + options + "\"";
+}
+
+wf::keymap_cache_t::keymap_cache_t()
+{
+    context    = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+    results_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (results_fd == -1)
+    {
+        LOGE("Failed to create eventfd, keymaps will be compiled synchronously.");
+        return;
+    }
+
+    results_source = wl_event_loop_add_fd(wl_display_get_event_loop(wf::get_core().display),
+        results_fd, WL_EVENT_READABLE, handle_results_fd, this);
+}
+
+wf::keymap_cache_t::~keymap_cache_t()
+{
+    for (auto& [names, request] : pending)
+    {
+        request.worker.join();
+    }
+
+    for (auto& [names, keymap] : results)
+    {
+        xkb_keymap_unref(keymap);
+    }
+
+    for (auto& [names, entry] : cache)
+    {
+        xkb_keymap_unref(entry.keymap);
+    }
+
+    if (results_source)
+    {
+        wl_event_source_remove(results_source);
+    }
+
+    if (results_fd != -1)
+    {
+        close(results_fd);
+    }
+
+    xkb_context_unref(context);
+}
+
+xkb_keymap*wf::keymap_cache_t::compile(xkb_context *context, const keymap_names_t& names)
+{
+    xkb_rule_names rmlvo;
+    rmlvo.rules   = names.rules.c_str();
+    rmlvo.model   = names.model.c_str();
+    rmlvo.layout  = names.layout.c_str();
+    rmlvo.variant = names.variant.c_str();
+    rmlvo.options = names.options.c_str();
+
+    auto start  = std::chrono::steady_clock::now();
+    auto keymap = xkb_keymap_new_from_names(context, &rmlvo, XKB_KEYMAP_COMPILE_NO_FLAGS);
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    LOGD("Compiled keymap ", names.describe(), " in ", duration.count() / 1000.0, "ms",
+        keymap ? "" : " (failed)");
+    return keymap;
+}
+
+xkb_keymap*wf::keymap_cache_t::store(const keymap_names_t& names, xkb_keymap *keymap)
+{
+    auto it = cache.find(names);
+    if (it != cache.end())
+    {
+        // Keyboards may already use the cached keymap, so keep it instead of the new one.
+        xkb_keymap_unref(keymap);
+        it->second.last_used = ++use_counter;
+        return it->second.keymap;
+    }
+
+    cache[names] = {keymap, ++use_counter};
+    if (cache.size() <= MAX_CACHED_KEYMAPS)
+    {
+        return keymap;
+    }
+
+    auto oldest = cache.begin();
+    for (auto it = cache.begin(); it != cache.end(); ++it)
+    {
+        if (it->second.last_used < oldest->second.last_used)
+        {
+            oldest = it;
+        }
+    }
+
+    // Keyboards hold their own reference to the keymap they use.
+    xkb_keymap_unref(oldest->second.keymap);
+    cache.erase(oldest);
+    return keymap;
+}
+
+xkb_keymap*wf::keymap_cache_t::get_keymap(const keymap_names_t& names)
+{
+    auto request = pending.find(names);
+    if (request != pending.end())
+    {
+        // Wait for the worker instead of compiling the same keymap a second time.
+        LOGC(KBD, "Waiting for keymap ", names.describe());
+        request->second.worker.join();
+        handle_results();
+    }
+
+    auto it = cache.find(names);
+    if (it != cache.end())
+    {
+        LOGC(KBD, "Using cached keymap ", names.describe());
+        it->second.last_used = ++use_counter;
+        return it->second.keymap;
+    }
+
+    return store(names, compile(context, names));
+}
+
+void wf::keymap_cache_t::request_keymap(const keymap_names_t& names, keymap_callback_t callback)
+{
+    if (cache.count(names) || (results_source == nullptr))
+    {
+        callback(get_keymap(names));
+        return;
+    }
+
+    auto it = pending.find(names);
+    if (it != pending.end())
+    {
+        it->second.callbacks.push_back(std::move(callback));
+        return;
+    }
+
+    LOGC(KBD, "Compiling keymap ", names.describe(), " in the background");
+    auto& request = pending[names];
+    request.callbacks.push_back(std::move(callback));
+    request.worker = std::thread([this, names] ()
+    {
+        // xkb contexts may not be shared between threads, so every worker uses its own context. The
+        // compiled keymap keeps a reference to it, which is released together with the keymap.
+        auto worker_context = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+        auto keymap = compile(worker_context, names);
+        xkb_context_unref(worker_context);
+
+        std::lock_guard<std::mutex> lock(results_mutex);
+        results.emplace_back(names, keymap);
+        eventfd_write(results_fd, 1);
+    });
+}
+
+int wf::keymap_cache_t::handle_results_fd(int fd, uint32_t mask, void *data)
+{
+    eventfd_t value;
+    eventfd_read(fd, &value);
+    static_cast<keymap_cache_t*>(data)->handle_results();
+    return 0;
+}
+
+void wf::keymap_cache_t::handle_results()
+{
+    std::vector<std::pair<keymap_names_t, xkb_keymap*>> ready;
+    {
+        std::lock_guard<std::mutex> lock(results_mutex);
+        std::swap(ready, results);
+    }
+
+    for (auto& [names, keymap] : ready)
+    {
+        auto it = pending.find(names);
+        if (it->second.worker.joinable())
+        {
+            it->second.worker.join();
+        }
+
+        auto callbacks = std::move(it->second.callbacks);
+        pending.erase(it);
+
+        keymap = store(names, keymap);
+        for (auto& callback : callbacks)
+        {
+            callback(keymap);
+        }
+    }
+}
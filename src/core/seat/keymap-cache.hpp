@@ -0,0 +1,105 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include <xkbcommon/xkbcommon.h>
+
+struct wl_event_source;
+
+namespace wf
+{
+/**
+ * The RMLVO names which describe a keymap.
+ */
+struct keymap_names_t
+{
+    std::string rules;
+    std::string model;
+    std::string layout;
+    std::string variant;
+    std::string options;
+
+    bool operator <(const keymap_names_t& other) const
+    {
+        return std::tie(rules, model, layout, variant, options) <
+               std::tie(other.rules, other.model, other.layout, other.variant, other.options);
+    }
+
+    /** A human-readable description of the names, for log messages. */
+    std::string describe() const;
+};
+
+/**
+ * A cache of compiled keymaps, shared by all keyboard devices.
+ *
+ * Compiling a keymap takes tens of milliseconds, so keyboards with the same configuration (as is the case
+ * for most setups) share a single keymap, and keymaps which are not cached yet can be compiled on a worker
+ * thread while the keyboards keep using their old keymap.
+ */
+class keymap_cache_t
+{
+  public:
+    keymap_cache_t();
+    ~keymap_cache_t();
+
+    /** The callback for asynchronous requests, called with a borrowed keymap, or nullptr on failure. */
+    using keymap_callback_t = std::function<void (xkb_keymap*)>;
+
+    /**
+     * Get the keymap for the given names, compiling it on the calling thread if it is not cached yet. If a
+     * worker is already compiling it, wait for the worker instead, and run the callbacks waiting for it.
+     *
+     * @return A borrowed reference to the keymap, or nullptr if it cannot be compiled.
+     */
+    xkb_keymap *get_keymap(const keymap_names_t& names);
+
+    /**
+     * Get the keymap for the given names. If the keymap is cached, the callback is called immediately,
+     * otherwise the keymap is compiled on a worker thread and the callback is called from the event loop
+     * once it is ready.
+     */
+    void request_keymap(const keymap_names_t& names, keymap_callback_t callback);
+
+  private:
+    /** The maximal number of cached keymaps, older keymaps are dropped first. */
+    static constexpr size_t MAX_CACHED_KEYMAPS = 16;
+
+    struct entry_t
+    {
+        xkb_keymap *keymap;
+        uint64_t last_used;
+    };
+
+    struct pending_t
+    {
+        std::thread worker;
+        std::vector<keymap_callback_t> callbacks;
+    };
+
+    xkb_context *context;
+    std::map<keymap_names_t, entry_t> cache;
+    std::map<keymap_names_t, pending_t> pending;
+    uint64_t use_counter = 0;
+
+    /** Keymaps compiled by the workers, protected by results_mutex. */
+    std::mutex results_mutex;
+    std::vector<std::pair<keymap_names_t, xkb_keymap*>> results;
+    int results_fd = -1;
+    wl_event_source *results_source = nullptr;
+
+    /**
+     * Add a newly compiled keymap to the cache, taking over its reference.
+     * @return The cached keymap, which is a different one if the names were already cached.
+     */
+    xkb_keymap *store(const keymap_names_t& names, xkb_keymap *keymap);
+    void handle_results();
+
+    static xkb_keymap *compile(xkb_context *context, const keymap_names_t& names);
+    static int handle_results_fd(int fd, uint32_t mask, void *data);
+};
+}
@@ -10,6 +10,8 @@
 #include <wayfire/util/log.hpp>
 #include <wayfire/core.hpp>
 #include <wayfire/output-layout.hpp>
+#include <wayfire/output.hpp>
+#include <wayfire/input-device.hpp>
 
 wf::pointer_t::pointer_t(nonstd::observer_ptr<wf::input_manager_t> input,
     nonstd::observer_ptr<seat_t> seat)
@@ -33,10 +35,41 @@ wf::pointer_t::pointer_t(nonstd::observer_ptr<wf::input_manager_t> input,
     };
 
     wf::get_core().scene()->connect(&on_root_node_updated);
+
+    on_motion_frame = [=] (int64_t)
+    {
+        // The hook is removed after returning false.
+        pending_motion_output = nullptr;
+        flush_pointer_motion();
+        return false;
+    };
+
+    on_output_pre_remove = [=] (wf::output_pre_remove_signal *ev)
+    {
+        if (ev->output == pending_motion_output)
+        {
+            flush_pointer_motion();
+        }
+    };
+    wf::get_core().output_layout->connect(&on_output_pre_remove);
+
+    on_device_removed = [=] (wf::input_device_removed_signal *ev)
+    {
+        if (pending_motion && (&pending_motion->pointer->base == ev->device->get_wlr_handle()))
+        {
+            flush_pointer_motion();
+        }
+    };
+    wf::get_core().connect(&on_device_removed);
 }
 
 wf::pointer_t::~pointer_t()
-{}
+{
+    if (pending_motion_output)
+    {
+        pending_motion_output->render->rem_animation(&on_motion_frame);
+    }
+}
 
 bool wf::pointer_t::has_pressed_buttons() const
 {
@@ -271,6 +304,7 @@ void wf::pointer_t::send_button(wlr_pointer_button_event *ev, bool has_binding)
             LOGC(POINTER, "normal button press ", ev->button);
             this->currently_sent_buttons.insert(ev->button);
             cursor_focus->pointer_interaction().handle_pointer_button(*ev);
+            seat->priv->latency_tracer.trace(ev->time_msec, seat->seat->pointer_state.focused_surface);
         } else if ((ev->state == WL_POINTER_BUTTON_STATE_RELEASED) &&
                    (currently_sent_buttons.count(ev->button) || cursor_focus->wants_raw_input()))
         {
@@ -308,13 +342,126 @@ void wf::pointer_t::send_motion(uint32_t time_msec)
             // infinite loops.
             last_focus_coords = local;
             cursor_focus->pointer_interaction().handle_pointer_motion(local, time_msec);
+            seat->priv->latency_tracer.trace(time_msec, seat->seat->pointer_state.focused_surface);
+        }
+    }
+}
+
+bool wf::pointer_t::can_coalesce_motion() const
+{
+    if (!coalesce_motion)
+    {
+        return false;
+    }
+
+    // Constrained clients (typically games) get every motion event. Moreover, confinement is computed
+    // relative to the current cursor position, which is outdated while motion is pending.
+    auto surface = seat->seat->pointer_state.focused_surface;
+    if (!surface)
+    {
+        return true;
+    }
+
+    if (wlr_pointer_constraints_v1_constraint_for_surface(
+        wf::get_core().protocols.pointer_constraints, surface, seat->seat))
+    {
+        return false;
+    }
+
+    // Raw relative motion must reach relative pointer clients unthrottled. It is sent right away, but
+    // clients apply it on the following wl_pointer.frame, which is deferred together with the motion.
+    wl_client *client = wl_resource_get_client(surface->resource);
+    wlr_relative_pointer_v1 *relative_pointer;
+    wl_list_for_each(relative_pointer,
+        &wf::get_core().protocols.relative_pointer->relative_pointers, link)
+    {
+        if ((relative_pointer->seat == seat->seat) &&
+            (wl_resource_get_client(relative_pointer->resource) == client))
+        {
+            return false;
         }
     }
+
+    return true;
+}
+
+bool wf::pointer_t::queue_pointer_motion(wlr_pointer_motion_event *ev)
+{
+    motion_stats.events++;
+    if (pending_motion && (!can_coalesce_motion() || (pending_motion->pointer != ev->pointer)))
+    {
+        flush_pointer_motion();
+    }
+
+    if (pending_motion)
+    {
+        pending_motion->time_msec   = ev->time_msec;
+        pending_motion->delta_x    += ev->delta_x;
+        pending_motion->delta_y    += ev->delta_y;
+        pending_motion->unaccel_dx += ev->unaccel_dx;
+        pending_motion->unaccel_dy += ev->unaccel_dy;
+        motion_stats.coalesced++;
+        return true;
+    }
+
+    if (!can_coalesce_motion())
+    {
+        return false;
+    }
+
+    // Disabled outputs do not produce frames, so there is nothing to synchronize with.
+    auto gc     = seat->priv->cursor->get_cursor_position();
+    auto output = wf::get_core().output_layout->get_output_at(gc.x, gc.y);
+    if (!output || !output->handle->enabled)
+    {
+        return false;
+    }
+
+    pending_motion = *ev;
+    pending_motion_output = output;
+    output->render->add_animation(&on_motion_frame);
+    return true;
+}
+
+void wf::pointer_t::flush_pointer_motion()
+{
+    if (!pending_motion)
+    {
+        return;
+    }
+
+    if (pending_motion_output)
+    {
+        pending_motion_output->render->rem_animation(&on_motion_frame);
+        pending_motion_output = nullptr;
+    }
+
+    auto ev = *pending_motion;
+    pending_motion.reset();
+    handle_pointer_motion(&ev, input_event_processing_mode_t::FULL);
+    emit_device_post_event_signal(&ev, &ev.pointer->base);
+
+    if (pending_frame)
+    {
+        pending_frame = false;
+        handle_pointer_frame();
+    }
+}
+
+wf::pointer_motion_stats_t wf::pointer_t::get_motion_stats() const
+{
+    return motion_stats;
+}
+
+void wf::pointer_t::reset_motion_stats()
+{
+    motion_stats = {};
 }
 
 void wf::pointer_t::handle_pointer_motion(wlr_pointer_motion_event *ev,
     input_event_processing_mode_t mode)
 {
+    motion_stats.dispatched++;
     /* XXX: maybe warp directly? */
     wlr_cursor_move(seat->priv->cursor->cursor, &ev->pointer->base, ev->delta_x, ev->delta_y);
     update_cursor_position(ev->time_msec);
@@ -433,5 +580,12 @@ void wf::pointer_t::handle_pointer_hold_end(wlr_pointer_hold_end_event *ev,
 
 void wf::pointer_t::handle_pointer_frame()
 {
+    if (pending_motion)
+    {
+        // Send the frame together with the motion it belongs to.
+        pending_frame = true;
+        return;
+    }
+
     wlr_seat_pointer_notify_frame(seat->seat);
 }
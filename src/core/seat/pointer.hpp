@@ -9,6 +9,9 @@
 #include "wayfire/scene-input.hpp"
 #include "wayfire/signal-definitions.hpp"
 #include "wayfire/signal-provider.hpp"
+#include "wayfire/render-manager.hpp"
+#include "wayfire/output-layout.hpp"
+#include "wayfire/seat.hpp"
 #include <wayfire/nonstd/wlroots-full.hpp>
 
 namespace wf
@@ -71,6 +74,28 @@ class pointer_t
         input_event_processing_mode_t mode);
     void handle_pointer_frame();
 
+    /**
+     * Try to defer the processing of a relative motion event until the next frame of the output under the
+     * cursor, merging it with the other motion events which arrive until then. This is done only if the
+     * input/coalesce_pointer_motion option is enabled and the focused surface has no pointer constraint.
+     *
+     * The event must have already been sent to the input_event_signal listeners, so that relative pointer
+     * motion is still sent to clients for every event.
+     *
+     * @return True if the event was deferred. In this case, the post_input_event_signal is emitted once
+     *   the merged motion is processed. Otherwise, the caller should process the event as usual.
+     */
+    bool queue_pointer_motion(wlr_pointer_motion_event *ev);
+
+    /**
+     * Process any deferred relative motion immediately.
+     */
+    void flush_pointer_motion();
+
+    /** Get the counters for the relative motion events handled by the pointer. */
+    pointer_motion_stats_t get_motion_stats() const;
+    void reset_motion_stats();
+
     /** Whether there are pressed buttons currently */
     bool has_pressed_buttons() const;
 
@@ -104,6 +129,26 @@ class pointer_t
     wf::signal::connection_t<wf::scene::root_node_update_signal>
     on_root_node_updated;
 
+    wf::option_wrapper_t<bool> coalesce_motion{"input/coalesce_pointer_motion"};
+    pointer_motion_stats_t motion_stats;
+
+    /** The merged relative motion which has not been processed yet. */
+    std::optional<wlr_pointer_motion_event> pending_motion;
+    /** The output whose next frame processes the pending motion. */
+    wf::output_t *pending_motion_output = nullptr;
+    /** Whether a pointer frame event was received for the pending motion. */
+    bool pending_frame = false;
+
+    wf::animation_hook_t on_motion_frame;
+    wf::signal::connection_t<wf::output_pre_remove_signal> on_output_pre_remove;
+    wf::signal::connection_t<wf::input_device_removed_signal> on_device_removed;
+
+    /**
+     * Whether relative motion events may be deferred currently. They are not deferred for constrained
+     * surfaces and for clients with a relative pointer.
+     */
+    bool can_coalesce_motion() const;
+
     /** The surface which currently has cursor focus */
     wf::scene::node_ptr cursor_focus = nullptr;
     /** Whether focusing is enabled */
@@ -13,6 +13,7 @@
 #include "wayfire/signal-provider.hpp"
 #include "wayfire/toplevel-view.hpp"
 #include "wayfire/util.hpp"
+#include "input-latency-tracer.hpp"
 
 namespace wf
 {
@@ -131,6 +132,8 @@ struct seat_t::impl
 
     // Last serial used for button press, release, touch down/up and or tablet tip events.
     uint32_t last_press_release_serial = 0;
+
+    input_latency_tracer_t latency_tracer;
 };
 }
 
@@ -240,6 +240,26 @@ std::vector<uint32_t> wf::seat_t::get_pressed_keys()
     return pressed_keys;
 }
 
+wf::pointer_motion_stats_t wf::seat_t::get_pointer_motion_stats() const
+{
+    return priv->lpointer->get_motion_stats();
+}
+
+void wf::seat_t::reset_pointer_motion_stats()
+{
+    priv->lpointer->reset_motion_stats();
+}
+
+wf::input_latency_stats_t wf::seat_t::get_input_latency_stats() const
+{
+    return priv->latency_tracer.get_stats();
+}
+
+void wf::seat_t::reset_input_latency_stats()
+{
+    priv->latency_tracer.reset_stats();
+}
+
 /* ----------------------- wf::seat_t implementation ------------------------ */
 wf::seat_t::seat_t(wl_display *display, std::string name) : seat(wlr_seat_create(display, name.c_str()))
 {
@@ -0,0 +1,78 @@
+#include <wayfire/txn/throttled-scheduler.hpp>
+#include <wayfire/txn/transaction.hpp>
+#include <wayfire/debug.hpp>
+
+struct wf::txn::throttled_scheduler_t::impl
+{
+    transaction_manager_t& manager;
+    transaction_object_sptr object;
+    transaction_factory_t factory;
+    bool deferred = false;
+
+    impl(transaction_manager_t& manager, transaction_object_sptr object, transaction_factory_t factory) :
+        manager(manager), object(std::move(object)), factory(std::move(factory))
+    {
+        manager.connect(&on_tx_applied);
+    }
+
+    bool is_in_flight() const
+    {
+        return manager.is_object_pending(object) || manager.is_object_committed(object);
+    }
+
+    void schedule_now()
+    {
+        deferred = false;
+        auto tx = factory ? factory() : transaction_t::create();
+        tx->add_object(object);
+        manager.schedule_transaction(std::move(tx));
+    }
+
+    wf::signal::connection_t<transaction_applied_signal> on_tx_applied = [=] (transaction_applied_signal*)
+    {
+        // The object may be part of another transaction which is still in flight (for example, if another
+        // plugin scheduled it too), in which case we wait for that one as well.
+        if (deferred && !is_in_flight())
+        {
+            LOGC(TXNI, "Scheduling deferred transaction for ", object->stringify());
+            schedule_now();
+        }
+    };
+};
+
+wf::txn::throttled_scheduler_t::throttled_scheduler_t(transaction_manager_t& manager,
+    transaction_object_sptr object, transaction_factory_t factory)
+{
+    priv = std::make_unique<impl>(manager, std::move(object), std::move(factory));
+}
+
+wf::txn::throttled_scheduler_t::~throttled_scheduler_t() = default;
+
+void wf::txn::throttled_scheduler_t::schedule()
+{
+    if (priv->is_in_flight())
+    {
+        priv->deferred = true;
+        return;
+    }
+
+    priv->schedule_now();
+}
+
+void wf::txn::throttled_scheduler_t::flush()
+{
+    if (priv->deferred)
+    {
+        priv->schedule_now();
+    }
+}
+
+bool wf::txn::throttled_scheduler_t::has_deferred() const
+{
+    return priv->deferred;
+}
+
+bool wf::txn::throttled_scheduler_t::is_in_flight() const
+{
+    return priv->is_in_flight();
+}
@@ -1,20 +1,12 @@
 #include "wayfire/signal-provider.hpp"
 #include "wayfire/txn/transaction.hpp"
 #include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <wayfire/txn/transaction-manager.hpp>
 #include <wayfire/debug.hpp>
 
-static bool transactions_intersect(const wf::txn::transaction_uptr& a, const wf::txn::transaction_uptr& b)
-{
-    const auto& obj_a = a->get_objects();
-    const auto& obj_b = b->get_objects();
-
-    return std::any_of(obj_a.begin(), obj_a.end(), [&] (const wf::txn::transaction_object_sptr& x)
-    {
-        return std::find(obj_b.begin(), obj_b.end(), x) != obj_b.end();
-    });
-}
-
 struct wf::txn::transaction_manager_t::impl
 {
     impl()
@@ -27,45 +19,65 @@ struct wf::txn::transaction_manager_t::impl
         LOGC(TXN, "Scheduling transaction ", tx.get());
 
         // Step 1: add any objects which are directly or indirectly connected to the objects in tx
-        coalesce_transactions(tx);
+        auto merged = coalesce_transactions(tx);
 
         // Step 2: remove any transactions we don't need anymore, as their objects were added to tx
-        remove_conflicts(tx);
+        remove_conflicts(merged);
 
         // Step 3: schedule tx for execution. At this point, there are no conflicts in all pending txs
+        for (auto& obj : tx->get_objects())
+        {
+            pending_owner[obj.get()] = tx.get();
+        }
+
         pending.push_back(std::move(tx));
         consider_commit();
     }
 
-    void coalesce_transactions(const transaction_uptr& tx)
+    /**
+     * Add the objects of all pending transactions which share an object with tx to tx.
+     *
+     * Pending transactions never share objects (they are merged when scheduled), so every object belongs to
+     * at most one pending transaction and a single pass over the objects of tx is enough: the objects added
+     * from a pending transaction cannot lead to another pending transaction.
+     *
+     * @return The pending transactions which were merged into tx.
+     */
+    std::unordered_set<transaction_t*> coalesce_transactions(const transaction_uptr& tx)
     {
-        while (true)
+        std::unordered_set<transaction_t*> merged;
+
+        // tx->add_object() may grow the object list, but the new objects cannot have other pending owners.
+        const size_t initial_size = tx->get_objects().size();
+        for (size_t i = 0; i < initial_size; i++)
         {
-            const size_t start_size = tx->get_objects().size();
-            for (auto& existing : pending)
+            auto it = pending_owner.find(tx->get_objects()[i].get());
+            if ((it == pending_owner.end()) || !merged.insert(it->second).second)
             {
-                if (transactions_intersect(existing, tx))
-                {
-                    for (auto& obj : existing->get_objects())
-                    {
-                        tx->add_object(obj);
-                    }
-                }
+                continue;
             }
 
-            if (start_size == tx->get_objects().size())
+            for (auto& obj : it->second->get_objects())
             {
-                // No new objects were added in the last iteration => done
-                break;
+                tx->add_object(obj);
             }
         }
+
+        return merged;
     }
 
-    void remove_conflicts(const transaction_uptr& tx)
+    void remove_conflicts(const std::unordered_set<transaction_t*>& merged)
     {
+        if (merged.empty())
+        {
+            return;
+        }
+
+        // The objects of the merged transactions are now owned by the new transaction, so pending_owner is
+        // updated when it is added.
         auto it = std::remove_if(pending.begin(), pending.end(), [&] (const transaction_uptr& existing)
         {
-            return transactions_intersect(existing, tx);
+            return merged.count(existing.get());
         });
         pending.erase(it, pending.end());
     }
@@ -95,25 +107,90 @@ struct wf::txn::transaction_manager_t::impl
 
     bool can_commit_transaction(const transaction_uptr& tx)
     {
-        return std::none_of(committed.begin(), committed.end(), [&] (const transaction_uptr& comm)
+        return std::none_of(tx->get_objects().begin(), tx->get_objects().end(), [&] (auto& obj)
         {
-            return transactions_intersect(tx, comm);
+            return committed_owner.count(obj.get());
         });
     }
 
     void do_commit(transaction_uptr tx)
     {
+        for (auto& obj : tx->get_objects())
+        {
+            pending_owner.erase(obj.get());
+            committed_owner[obj.get()] = tx.get();
+        }
+
         tx->connect(&on_tx_apply);
         committed.push_back(std::move(tx));
         // Note: this might immediately trigger tx_apply if all objects are already ready!
         committed.back()->commit();
     }
 
+    // The public transaction manager, which re-emits the transaction-applied signal (if any).
+    wf::signal::provider_t *owner = nullptr;
+
     std::vector<transaction_uptr> done; // Temporary storage for transactions which are complete
     std::vector<transaction_uptr> committed;
     std::vector<transaction_uptr> pending;
     wf::wl_idle_call idle_clear_done;
 
+    // Index of the pending/committed transaction each object is part of. Pending transactions are disjoint,
+    // and so are committed transactions, so each object has at most one owner in each map.
+    std::unordered_map<transaction_object_t*, transaction_t*> pending_owner;
+    std::unordered_map<transaction_object_t*, transaction_t*> committed_owner;
+
+    // Latency statistics per client, indexed by app_id and pid.
+    static constexpr size_t MAX_CLIENT_STATS = 256;
+    std::map<std::pair<std::string, int>, client_transaction_stats_t> client_stats;
+
+    void record_latency(transaction_t *tx, bool timed_out)
+    {
+        const int64_t commit_time = tx->get_commit_time();
+        if (commit_time < 0)
+        {
+            return;
+        }
+
+        for (auto& obj : tx->get_objects())
+        {
+            auto client = obj->get_client_info();
+            if (client.app_id.empty() && (client.pid < 0))
+            {
+                continue;
+            }
+
+            auto key = std::make_pair(client.app_id, client.pid);
+            auto it  = client_stats.find(key);
+            if (it == client_stats.end())
+            {
+                if (client_stats.size() >= MAX_CLIENT_STATS)
+                {
+                    // Forget the least active client, most likely one which is long gone.
+                    client_stats.erase(std::min_element(client_stats.begin(), client_stats.end(),
+                        [] (auto& a, auto& b) { return a.second.apply.count < b.second.apply.count; }));
+                }
+
+                it = client_stats.emplace(key, client_transaction_stats_t{}).first;
+                it->second.client = client;
+            }
+
+            auto& stats = it->second;
+            const int64_t ready_time = tx->get_ready_time(obj.get());
+            if (ready_time >= 0)
+            {
+                stats.ready.add(ready_time - commit_time);
+            } else if (timed_out)
+            {
+                LOGC(TXN, "Transaction ", tx, " timed out waiting for ", client.app_id, " (pid ", client.pid,
+                    ")");
+                stats.timeouts++;
+            }
+
+            stats.apply.add(tx->get_apply_time() - commit_time);
+        }
+    }
+
     wf::signal::connection_t<transaction_applied_signal> on_tx_apply = [&] (transaction_applied_signal *ev)
     {
         // Move transactions which are done from committed to done.
@@ -124,9 +201,22 @@ struct wf::txn::transaction_manager_t::impl
         });
 
         wf::dassert(it != committed.end(), "Transaction not found in committed list");
+        record_latency(ev->self, ev->timed_out);
+        for (auto& obj : ev->self->get_objects())
+        {
+            auto owner = committed_owner.find(obj.get());
+            if ((owner != committed_owner.end()) && (owner->second == ev->self))
+            {
+                committed_owner.erase(owner);
+            }
+        }
 
         done.push_back(std::move(*it));
         committed.erase(it);
         consider_commit();
+        if (owner)
+        {
+            owner->emit(ev);
+        }
     };
 };
@@ -7,6 +7,7 @@
 wf::txn::transaction_manager_t::transaction_manager_t()
 {
     this->priv = std::make_unique<impl>();
+    this->priv->owner = this;
 }
 
 wf::txn::transaction_manager_t::~transaction_manager_t() = default;
@@ -26,24 +27,42 @@ void wf::txn::transaction_manager_t::schedule_object(transaction_object_sptr obj
     schedule_transaction(std::move(tx));
 }
 
-template<class T>
-static bool is_contained(const std::vector<T>& objs, const T& object)
+bool wf::txn::transaction_manager_t::is_object_pending(transaction_object_sptr object) const
 {
-    return std::find(objs.begin(), objs.end(), object) != objs.end();
+    return this->priv->pending_owner.count(object.get());
 }
 
-bool wf::txn::transaction_manager_t::is_object_pending(transaction_object_sptr object) const
+bool wf::txn::transaction_manager_t::is_object_committed(transaction_object_sptr object) const
+{
+    return this->priv->committed_owner.count(object.get());
+}
+
+void wf::txn::latency_histogram_t::add(int64_t latency_us)
 {
-    return std::any_of(this->priv->pending.begin(), this->priv->pending.end(), [&] (auto& pending)
+    int bucket = 0;
+    while ((bucket < NUM_BUCKETS - 1) && (latency_us >= (1000ll << bucket)))
     {
-        return is_contained(pending->get_objects(), object);
-    });
+        ++bucket;
+    }
+
+    buckets[bucket]++;
+    count++;
+    total_us += latency_us;
+    max_us    = std::max(max_us, latency_us);
 }
 
-bool wf::txn::transaction_manager_t::is_object_committed(transaction_object_sptr object) const
+std::vector<wf::txn::client_transaction_stats_t> wf::txn::transaction_manager_t::get_client_stats() const
 {
-    return std::any_of(this->priv->committed.begin(), this->priv->committed.end(), [&] (auto& committed)
+    std::vector<client_transaction_stats_t> result;
+    for (auto& [_, stats] : priv->client_stats)
     {
-        return is_contained(committed->get_objects(), object);
-    });
+        result.push_back(stats);
+    }
+
+    return result;
+}
+
+void wf::txn::transaction_manager_t::reset_client_stats()
+{
+    priv->client_stats.clear();
 }
@@ -2,6 +2,7 @@
 #include "wayfire/txn/transaction-object.hpp"
 #include <wayfire/txn/transaction.hpp>
 #include <sstream>
+#include <chrono>
 #include <wayfire/debug.hpp>
 
 std::string wf::txn::transaction_object_t::stringify() const
@@ -11,6 +12,12 @@ std::string wf::txn::transaction_object_t::stringify() const
     return out.str();
 }
 
+static int64_t get_txn_time()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
 wf::txn::transaction_t::transaction_t(uint64_t timeout, timer_setter_t timer_setter)
 {
     this->timeout = timeout;
@@ -19,6 +26,7 @@ wf::txn::transaction_t::transaction_t(uint64_t timeout, timer_setter_t timer_set
     this->on_object_ready = [=] (object_ready_signal *ev)
     {
         this->count_ready_objects++;
+        this->ready_times[ev->self] = get_txn_time();
         LOGC(TXNI, "Transaction ", this, " object ", ev->self->stringify(), " became ready (",
             count_ready_objects, "/", this->objects.size(), ")");
 
@@ -37,17 +45,33 @@ const std::vector<wf::txn::transaction_object_sptr>& wf::txn::transaction_t::get
 
 void wf::txn::transaction_t::add_object(transaction_object_sptr object)
 {
-    auto it = std::find(objects.begin(), objects.end(), object);
-    if (it == objects.end())
+    if (object_set.insert(object.get()).second)
     {
         LOGC(TXNI, "Transaction ", this, " add object ", object->stringify());
         objects.push_back(object);
     }
 }
 
+int64_t wf::txn::transaction_t::get_commit_time() const
+{
+    return this->commit_time;
+}
+
+int64_t wf::txn::transaction_t::get_ready_time(transaction_object_t *object) const
+{
+    auto it = ready_times.find(object);
+    return (it == ready_times.end()) ? -1 : it->second;
+}
+
+int64_t wf::txn::transaction_t::get_apply_time() const
+{
+    return this->apply_time;
+}
+
 void wf::txn::transaction_t::commit()
 {
     LOGC(TXN, "Committing transaction ", this, " with timeout ", this->timeout);
+    this->commit_time = get_txn_time();
     if (this->objects.empty())
     {
         // Empty transaction, directly ready.
@@ -75,6 +99,7 @@ void wf::txn::transaction_t::commit()
 void wf::txn::transaction_t::apply(bool did_timeout)
 {
     on_object_ready.disconnect();
+    this->apply_time = get_txn_time();
 
     LOGC(TXN, "Applying transaction ", this, " timed_out: ", did_timeout);
     for (auto& obj : this->objects)
@@ -0,0 +1,279 @@
+#include <wayfire/view-registry.hpp>
+#include <wayfire/core.hpp>
+#include <wayfire/toplevel-view.hpp>
+#include <wayfire/signal-definitions.hpp>
+#include <wayfire/nonstd/tracking-allocator.hpp>
+#include <algorithm>
+
+namespace
+{
+template<class Key>
+using view_index_t = std::unordered_map<Key, std::vector<wayfire_view>>;
+
+template<class Key>
+void index_add(view_index_t<Key>& index, const Key& key, wayfire_view view)
+{
+    index[key].push_back(view);
+}
+
+template<class Key>
+void index_remove(view_index_t<Key>& index, const Key& key, wayfire_view view)
+{
+    auto it = index.find(key);
+    if (it == index.end())
+    {
+        return;
+    }
+
+    auto& views = it->second;
+    views.erase(std::remove(views.begin(), views.end(), view), views.end());
+    if (views.empty())
+    {
+        index.erase(it);
+    }
+}
+
+template<class Key>
+const std::vector<wayfire_view>& index_get(const view_index_t<Key>& index, const Key& key)
+{
+    static const std::vector<wayfire_view> empty;
+    auto it = index.find(key);
+    return (it == index.end()) ? empty : it->second;
+}
+}
+
+struct wf::view_registry_t::impl
+{
+    /** The indexed properties of a mapped view, as of the last update. */
+    struct entry_t
+    {
+        std::string app_id;
+        wf::output_t *output;
+        wf::workspace_set_t *wset;
+        view_role_t role;
+        // Increases with the mapping order.
+        uint64_t serial = 0;
+    };
+
+    std::unordered_map<view_interface_t*, entry_t> entries;
+    std::unordered_map<uint32_t, wayfire_view> by_id;
+    std::vector<wayfire_view> mapped;
+
+    view_index_t<std::string> by_app_id;
+    view_index_t<wf::output_t*> by_output;
+    view_index_t<wf::workspace_set_t*> by_wset;
+    view_index_t<int> by_role;
+    uint64_t next_serial = 0;
+
+    static entry_t make_entry(wayfire_view view)
+    {
+        auto toplevel = toplevel_cast(view);
+
+        entry_t entry;
+        entry.app_id = view->get_app_id();
+        entry.output = view->get_output();
+        entry.wset   = toplevel ? toplevel->get_wset().get() : nullptr;
+        entry.role   = view->role;
+        return entry;
+    }
+
+    void add_to_indexes(wayfire_view view, const entry_t& entry)
+    {
+        index_add(by_app_id, entry.app_id, view);
+        index_add(by_output, entry.output, view);
+        index_add(by_role, (int)entry.role, view);
+        if (entry.wset)
+        {
+            index_add(by_wset, entry.wset, view);
+        }
+    }
+
+    void remove_from_indexes(wayfire_view view, const entry_t& entry)
+    {
+        index_remove(by_app_id, entry.app_id, view);
+        index_remove(by_output, entry.output, view);
+        index_remove(by_role, (int)entry.role, view);
+        if (entry.wset)
+        {
+            index_remove(by_wset, entry.wset, view);
+        }
+    }
+
+    void add_view(wayfire_view view)
+    {
+        if (entries.count(view.get()))
+        {
+            update_view(view);
+            return;
+        }
+
+        auto entry = make_entry(view);
+        entry.serial = next_serial++;
+        add_to_indexes(view, entry);
+        entries.emplace(view.get(), std::move(entry));
+        by_id[view->get_id()] = view;
+        mapped.push_back(view);
+    }
+
+    void remove_view(wayfire_view view)
+    {
+        auto it = entries.find(view.get());
+        if (it == entries.end())
+        {
+            return;
+        }
+
+        remove_from_indexes(view, it->second);
+        entries.erase(it);
+        by_id.erase(view->get_id());
+        mapped.erase(std::remove(mapped.begin(), mapped.end(), view), mapped.end());
+    }
+
+    void update_view(wayfire_view view)
+    {
+        auto it = entries.find(view.get());
+        if (it == entries.end())
+        {
+            return;
+        }
+
+        auto entry = make_entry(view);
+        entry.serial = it->second.serial;
+        auto& old = it->second;
+        if ((entry.app_id == old.app_id) && (entry.output == old.output) && (entry.wset == old.wset) &&
+            (entry.role == old.role))
+        {
+            return;
+        }
+
+        // Removing and adding moves the view to the end of its buckets, so restore the mapping order.
+        remove_from_indexes(view, old);
+        old = std::move(entry);
+        add_to_indexes(view, old);
+        sort_buckets(old);
+    }
+
+    void sort_buckets(const entry_t& entry)
+    {
+        auto sort_bucket = [&] (std::vector<wayfire_view>& views)
+        {
+            // Only the last view is out of place.
+            auto it = std::find_if(views.begin(), views.end() - 1, [&] (wayfire_view v)
+            {
+                return entries[v.get()].serial > entry.serial;
+            });
+            std::rotate(it, views.end() - 1, views.end());
+        };
+
+        sort_bucket(by_app_id[entry.app_id]);
+        sort_bucket(by_output[entry.output]);
+        sort_bucket(by_role[(int)entry.role]);
+        if (entry.wset)
+        {
+            sort_bucket(by_wset[entry.wset]);
+        }
+    }
+
+    wf::signal::connection_t<wf::view_mapped_signal> on_view_mapped = [=] (wf::view_mapped_signal *ev)
+    {
+        add_view(ev->view);
+    };
+
+    wf::signal::connection_t<wf::view_unmapped_signal> on_view_unmapped = [=] (wf::view_unmapped_signal *ev)
+    {
+        remove_view(ev->view);
+    };
+
+    wf::signal::connection_t<wf::view_set_output_signal> on_view_set_output =
+        [=] (wf::view_set_output_signal *ev)
+    {
+        update_view(ev->view);
+    };
+
+    wf::signal::connection_t<wf::view_moved_to_wset_signal> on_view_moved_to_wset =
+        [=] (wf::view_moved_to_wset_signal *ev)
+    {
+        update_view(ev->view);
+    };
+
+    wf::signal::connection_t<wf::view_app_id_changed_signal> on_view_app_id_changed =
+        [=] (wf::view_app_id_changed_signal *ev)
+    {
+        update_view(ev->view);
+    };
+};
+
+wf::view_registry_t::view_registry_t()
+{
+    priv = std::make_unique<impl>();
+    for (auto& view : get_all_views())
+    {
+        if (view->is_mapped())
+        {
+            priv->add_view(view);
+        }
+    }
+
+    auto& core = wf::get_core();
+    core.connect(&priv->on_view_mapped);
+    core.connect(&priv->on_view_unmapped);
+    core.connect(&priv->on_view_set_output);
+    core.connect(&priv->on_view_moved_to_wset);
+    core.connect(&priv->on_view_app_id_changed);
+}
+
+wf::view_registry_t::~view_registry_t() = default;
+
+const std::vector<wayfire_view>& wf::view_registry_t::get_all_views() const
+{
+    return wf::tracking_allocator_t<view_interface_t>::get().get_all();
+}
+
+const std::vector<wayfire_view>& wf::view_registry_t::get_mapped_views() const
+{
+    return priv->mapped;
+}
+
+wayfire_view wf::view_registry_t::find_view_by_id(uint32_t id) const
+{
+    auto it = priv->by_id.find(id);
+    if (it != priv->by_id.end())
+    {
+        return it->second;
+    }
+
+    for (auto& view : get_all_views())
+    {
+        if (view->get_id() == id)
+        {
+            return view;
+        }
+    }
+
+    return nullptr;
+}
+
+const std::vector<wayfire_view>& wf::view_registry_t::get_views_by_app_id(const std::string& app_id) const
+{
+    return index_get(priv->by_app_id, app_id);
+}
+
+const std::vector<wayfire_view>& wf::view_registry_t::get_views_on_output(wf::output_t *output) const
+{
+    return index_get(priv->by_output, output);
+}
+
+const std::vector<wayfire_view>& wf::view_registry_t::get_views_in_wset(wf::workspace_set_t *wset) const
+{
+    return index_get(priv->by_wset, wset);
+}
+
+const std::vector<wayfire_view>& wf::view_registry_t::get_views_by_role(view_role_t role) const
+{
+    return index_get(priv->by_role, (int)role);
+}
+
+void wf::view_registry_t::update_view(wayfire_view view)
+{
+    priv->update_view(view);
+}
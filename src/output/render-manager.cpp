@@ -399,6 +399,14 @@ struct swapchain_damage_manager_t
         force_next_frame = true;
     }
 
+    /**
+     * Request a frame event, but render only if the output gets damaged until then.
+     */
+    void schedule_frame()
+    {
+        wlr_output_schedule_frame(output);
+    }
+
     /**
      * Return the extents of the visible region for the output in the wlroots
      * damage coordinate system.
@@ -501,6 +509,45 @@ struct effect_hook_manager_t
     }
 };
 
+/**
+ * Ticks all animations of an output once per frame with the same frame time.
+ */
+struct animation_scheduler_t
+{
+    wf::safe_list_t<animation_hook_t*> animations;
+    int64_t frame_time = 0;
+
+    void add_animation(animation_hook_t *hook)
+    {
+        animations.push_back(hook);
+    }
+
+    void rem_animation(animation_hook_t *hook)
+    {
+        animations.remove_all(hook);
+    }
+
+    bool is_active() const
+    {
+        return animations.size() > 0;
+    }
+
+    /**
+     * Advance all animations to the given frame time.
+     */
+    void tick(int64_t time)
+    {
+        frame_time = time;
+        animations.for_each([&] (animation_hook_t *hook)
+        {
+            if (!(*hook)(time))
+            {
+                animations.remove_all(hook);
+            }
+        });
+    }
+};
+
 /**
  * A class to manage and run postprocessing effects
  */
@@ -824,6 +871,14 @@ struct repaint_delay_manager_t
         return delay;
     }
 
+    /**
+     * @return The refresh period of the output in milliseconds, or 0 if unknown.
+     */
+    int64_t get_refresh()
+    {
+        return refresh_nsec / 1'000'000;
+    }
+
   private:
     int delay = 0;
 
@@ -865,7 +920,7 @@ struct repaint_delay_manager_t
     // Time of last frame
     int64_t last_pageflip = -1; // -1 is invalid
 
-    int64_t refresh_nsec;
+    int64_t refresh_nsec = 0;
     wf::option_wrapper_t<int> max_render_time{"core/max_render_time"};
     wf::option_wrapper_t<bool> dynamic_delay{"workarounds/dynamic_repaint_delay"};
 
@@ -885,6 +940,7 @@ class wf::render_manager::impl
     std::unique_ptr<postprocessing_manager_t> postprocessing;
     std::unique_ptr<depth_buffer_manager_t> depth_buffer_manager;
     std::unique_ptr<repaint_delay_manager_t> delay_manager;
+    std::unique_ptr<animation_scheduler_t> animations;
 
     wf::option_wrapper_t<wf::color_t> background_color_opt;
     std::unique_ptr<wf::render_pass_t> current_pass;
@@ -902,6 +958,7 @@ class wf::render_manager::impl
         postprocessing = std::make_unique<postprocessing_manager_t>(o);
         depth_buffer_manager = std::make_unique<depth_buffer_manager_t>();
         delay_manager = std::make_unique<repaint_delay_manager_t>(o);
+        animations    = std::make_unique<animation_scheduler_t>();
 
         on_frame.set_callback([&] (void*)
         {
@@ -1140,7 +1197,11 @@ class wf::render_manager::impl
      */
     void paint()
     {
-        /* Part 1: frame setup: query damage, etc. */
+        /* Part 1: frame setup: advance animations, query damage, etc. */
+        // Nodes may have changed without damage or updates (e.g. a plugin changed a transformer and
+        // damaged the whole output), so refresh the input bounds used for hit testing at least once a frame.
+        wf::scene::invalidate_input_bounds();
+        run_animations();
         effects->run_effects(OUTPUT_EFFECT_PRE);
         effects->run_effects(OUTPUT_EFFECT_DAMAGE);
 
@@ -1148,6 +1209,7 @@ class wf::render_manager::impl
         {
             // Yet another optimization: if we can directly scanout, we should
             // stop the rest of the repaint cycle.
+            schedule_animation_frame(true);
             return;
         }
 
@@ -1157,6 +1219,7 @@ class wf::render_manager::impl
             // Optimization: the output doesn't need a new frame (so isn't damaged), so we can
             // just skip the whole repaint
             delay_manager->skip_frame();
+            schedule_animation_frame(false);
             return;
         }
 
@@ -1216,6 +1279,51 @@ class wf::render_manager::impl
         wlr_render_pass_submit(sw_cursor_pass);
     }
 
+    /**
+     * Tick all animations for the frame being prepared.
+     */
+    void run_animations()
+    {
+        // The frame event comes right after the previous frame was presented, so the new frame will be
+        // presented one refresh period after it.
+        const int64_t refresh = delay_manager->get_refresh();
+        int64_t frame_time    = get_current_time();
+        if (refresh > 0)
+        {
+            frame_time += refresh - delay_manager->get_delay();
+        }
+
+        animations->tick(frame_time);
+    }
+
+    wf::wl_timer<false> animation_timer;
+    /**
+     * Make sure that animations are ticked again on the next frame.
+     *
+     * @param frame_committed Whether a frame was committed in this repaint cycle. If so, the next frame event
+     *   comes after it is presented. Otherwise, the next tick is scheduled after one refresh period, so that
+     *   idle animations (which did not damage anything) do not cause a busy loop.
+     */
+    void schedule_animation_frame(bool frame_committed)
+    {
+        if (!animations->is_active())
+        {
+            return;
+        }
+
+        if (frame_committed)
+        {
+            damage_manager->schedule_frame();
+        } else if (!animation_timer.is_connected())
+        {
+            const int64_t refresh = delay_manager->get_refresh();
+            animation_timer.set_timeout(refresh > 0 ? refresh : 16, [=] ()
+            {
+                damage_manager->schedule_frame();
+            });
+        }
+    }
+
     /**
      * Execute post-paint actions.
      */
@@ -1226,6 +1334,8 @@ class wf::render_manager::impl
         {
             damage_manager->schedule_repaint();
         }
+
+        schedule_animation_frame(true);
     }
 };
 
@@ -1292,6 +1402,22 @@ void render_manager::rem_effect(effect_hook_t *hook)
     pimpl->effects->rem_effect(hook);
 }
 
+void render_manager::add_animation(animation_hook_t *hook)
+{
+    pimpl->animations->add_animation(hook);
+    pimpl->damage_manager->schedule_frame();
+}
+
+void render_manager::rem_animation(animation_hook_t *hook)
+{
+    pimpl->animations->rem_animation(hook);
+}
+
+int64_t render_manager::get_frame_time() const
+{
+    return pimpl->animations->frame_time;
+}
+
 void render_manager::add_post(post_hook_t *hook)
 {
     pimpl->postprocessing->add_post(hook);
@@ -24,8 +24,13 @@ wf::auxilliary_buffer_t& wf::auxilliary_buffer_t::operator =(auxilliary_buffer_t
         return *this;
     }
 
-    this->buffer = other.buffer;
+    free();
+    this->buffer  = other.buffer;
+    this->texture = other.texture;
+    this->hints   = other.hints;
     other.buffer.buffer = NULL;
+    other.buffer.size   = {0, 0};
+    other.texture = NULL;
     return *this;
 }
 
@@ -51,6 +56,22 @@ static const wlr_drm_format *choose_format_from_set(const wlr_drm_format_set *se
         DRM_FORMAT_BGRX8888,
     };
 
+    static std::vector<uint32_t> low_precision_formats = {
+        DRM_FORMAT_RGB565,
+        DRM_FORMAT_BGR565,
+    };
+
+    if (!hints.needs_alpha && hints.low_precision)
+    {
+        for (auto drm_format : low_precision_formats)
+        {
+            if (auto layout = wlr_drm_format_set_get(set, drm_format))
+            {
+                return layout;
+            }
+        }
+    }
+
     const auto& possible_formats = hints.needs_alpha ? alpha_formats : no_alpha_formats;
     for (auto drm_format : possible_formats)
     {
@@ -116,12 +137,14 @@ wf::buffer_reallocation_result_t wf::auxilliary_buffer_t::allocate(wf::dimension
     size.height = std::max(1.0f, std::ceil(size.height * scale));
     size = sanitize_buffer_size(size, max_buffer_size);
 
-    if (buffer.get_size() == size)
+    if ((buffer.get_size() == size) && (this->hints.needs_alpha == hints.needs_alpha) &&
+        (this->hints.low_precision == hints.low_precision))
     {
         return buffer_reallocation_result_t::SAME;
     }
 
     free();
+    this->hints = hints;
 
     auto renderer = wf::get_core().renderer;
     auto format   = choose_format(renderer, hints);
@@ -44,6 +44,7 @@ wf::point_t wf::scene::translation_node_t::get_offset() const
 void wf::scene::translation_node_t::set_offset(wf::point_t offset)
 {
     this->offset = offset;
+    invalidate_input_bounds();
 }
 
 uint32_t wf::scene::translation_node_t::optimize_update(uint32_t flags)
@@ -161,6 +161,16 @@ wf::pointf_t view_2d_transformer_t::to_global(const wf::pointf_t& point)
     return result + midpoint;
 }
 
+std::optional<wf::texture_t> view_2d_transformer_t::to_texture() const
+{
+    if ((std::abs(get_angle()) < 1e-3) && (get_alpha() >= 1.0f))
+    {
+        return get_children_zero_copy_texture();
+    }
+
+    return {};
+}
+
 std::string view_2d_transformer_t::stringify() const
 {
     if (auto _view = view.lock())
@@ -461,6 +471,19 @@ void view_3d_transformer_t::gen_render_instances(
     }
 }
 
+std::optional<wf::geometry_t> transform_manager_node_t::get_input_bounds()
+{
+    for (auto& tr : transformers)
+    {
+        if (!dynamic_cast<view_2d_transformer_t*>(tr.node.get()))
+        {
+            return {};
+        }
+    }
+
+    return get_bounding_box();
+}
+
 void transform_manager_node_t::begin_transform_update()
 {
     wf::scene::damage_node(this, get_bounding_box());
@@ -477,6 +500,35 @@ uint32_t transformer_base_node_t::optimize_update(uint32_t flags)
     return optimize_nested_render_instances(shared_from_this(), flags);
 }
 
+transformer_texture_stats_t& get_transformer_texture_stats()
+{
+    static transformer_texture_stats_t stats;
+    return stats;
+}
+
+std::optional<wf::texture_t> transformer_base_node_t::get_children_zero_copy_texture() const
+{
+    if (get_children().size() != 1)
+    {
+        return {};
+    }
+
+    auto zcopy = dynamic_cast<zero_copy_texturable_node_t*>(get_children().front().get());
+    if (!zcopy)
+    {
+        return {};
+    }
+
+    auto tex = zcopy->to_texture();
+    if (tex && (tex->transform != WL_OUTPUT_TRANSFORM_NORMAL))
+    {
+        // Transformers rendering with GLES do not handle buffer transforms, use the aux buffer for those.
+        return {};
+    }
+
+    return tex;
+}
+
 wf::texture_t transformer_base_node_t::get_updated_contents(const wf::geometry_t& bbox, float scale,
     std::vector<scene::render_instance_uptr>& children)
 {
@@ -485,6 +537,13 @@ wf::texture_t transformer_base_node_t::get_updated_contents(const wf::geometry_t
         cached_damage |= bbox;
     }
 
+    if (cached_damage.empty())
+    {
+        // The buffer already contains the current contents of the children.
+        get_transformer_texture_stats().aux_buffer_reused++;
+        return wf::texture_t{inner_content.get_texture(), {}};
+    }
+
     wf::render_target_t target{inner_content};
     target.scale    = scale;
     target.geometry = bbox;
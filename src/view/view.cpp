@@ -1,4 +1,6 @@
 #include <memory>
+#include <limits>
+#include <algorithm>
 #include <wayfire/util/log.hpp>
 #include <wayfire/workarea.hpp>
 #include "view-impl.hpp"
@@ -8,6 +10,7 @@
 #include "wayfire/scene-render.hpp"
 #include "wayfire/scene.hpp"
 #include "wayfire/view.hpp"
+#include "wayfire/view-registry.hpp"
 #include "wayfire/view-transform.hpp"
 
 #include <glm/glm.hpp>
@@ -17,6 +20,10 @@
 void wf::view_interface_t::set_role(view_role_t new_role)
 {
     role = new_role;
+    if (wf::get_core().view_registry)
+    {
+        wf::get_core().view_registry->update_view(self());
+    }
 }
 
 std::string wf::view_interface_t::to_string() const
@@ -91,12 +98,13 @@ bool wf::view_interface_t::has_transformer()
     return !ch.empty() && ch.front() != get_surface_root_node();
 }
 
-void wf::view_interface_t::take_snapshot(wf::auxilliary_buffer_t& buffer)
+void wf::view_interface_t::take_snapshot(wf::auxilliary_buffer_t& buffer, float scale,
+    wf::buffer_allocation_hints_t hints)
 {
     auto root_node = get_surface_root_node();
     const wf::geometry_t bbox = root_node->get_bounding_box();
-    float scale = get_output()->handle->scale;
-    buffer.allocate(wf::dimensions(bbox), scale);
+    scale *= get_output()->handle->scale;
+    buffer.allocate(wf::dimensions(bbox), scale, hints);
 
     wf::render_target_t target{buffer};
     target.geometry = bbox;
@@ -165,6 +173,42 @@ class view_root_node_t : public wf::scene::floating_inner_node_t, public wf::vie
         }
     }
 
+    std::optional<wf::geometry_t> get_input_bounds() override
+    {
+        // The view and its child views, if they all have bounds.
+        int min_x = std::numeric_limits<int>::max();
+        int min_y = std::numeric_limits<int>::max();
+        int max_x = std::numeric_limits<int>::min();
+        int max_y = std::numeric_limits<int>::min();
+
+        for (auto& ch : get_children())
+        {
+            if (!ch->is_enabled())
+            {
+                continue;
+            }
+
+            auto bounds = ch->get_input_bounds();
+            if (!bounds)
+            {
+                return {};
+            }
+
+            min_x = std::min(min_x, bounds->x);
+            min_y = std::min(min_y, bounds->y);
+            max_x = std::max(max_x, bounds->x + bounds->width);
+            max_y = std::max(max_y, bounds->y + bounds->height);
+        }
+
+        if (min_x > max_x)
+        {
+            // No enabled children => no input at all.
+            return wf::geometry_t{0, 0, 0, 0};
+        }
+
+        return wf::geometry_t{min_x, min_y, max_x - min_x, max_y - min_y};
+    }
+
   private:
     std::weak_ptr<wf::view_interface_t> view;
 };
@@ -7,6 +7,7 @@
 #include "wlr-surface-pointer-interaction.hpp"
 #include "wlr-surface-touch-interaction.cpp"
 #include "wayfire/output-layout.hpp"
+#include "wayfire/toplevel-view.hpp"
 #include <glm/gtc/matrix_transform.hpp>
 #include <memory>
 #include <sstream>
@@ -14,6 +15,61 @@
 #include <wayfire/signal-provider.hpp>
 #include <wlr/util/box.h>
 
+/** The number of frame_rate_cap_t instances, so that uncapped setups skip looking up the view. */
+static size_t frame_rate_caps = 0;
+
+wf::scene::frame_rate_cap_t::frame_rate_cap_t()
+{
+    ++frame_rate_caps;
+}
+
+wf::scene::frame_rate_cap_t::~frame_rate_cap_t()
+{
+    --frame_rate_caps;
+}
+
+void wf::scene::set_frame_rate_cap(wayfire_view view, int max_fps, bool only_unfocused)
+{
+    if (max_fps <= 0)
+    {
+        view->erase_data<frame_rate_cap_t>();
+        return;
+    }
+
+    auto cap = view->get_data_safe<frame_rate_cap_t>();
+    cap->max_fps = max_fps;
+    cap->only_unfocused = only_unfocused;
+}
+
+static wf::scene::frame_rate_cap_t *find_frame_rate_cap(wlr_surface *surface)
+{
+    if (frame_rate_caps == 0)
+    {
+        return nullptr;
+    }
+
+    auto root = wlr_surface_get_root_surface(surface);
+    auto view = wf::wl_surface_to_wayfire_view(root->resource);
+    if (!view)
+    {
+        return nullptr;
+    }
+
+    auto cap = view->get_data<wf::scene::frame_rate_cap_t>();
+    if (!cap || (cap->max_fps <= 0))
+    {
+        return nullptr;
+    }
+
+    auto toplevel = wf::toplevel_cast(view);
+    if (cap->only_unfocused && toplevel && toplevel->activated)
+    {
+        return nullptr;
+    }
+
+    return cap.get();
+}
+
 wf::scene::surface_state_t::surface_state_t(surface_state_t&& other)
 {
     if (&other != this)
@@ -107,6 +163,7 @@ wf::scene::wlr_surface_node_t::wlr_surface_node_t(wlr_surface *surface, bool aut
 
         on_surface_commit.disconnect();
         on_surface_destroyed.disconnect();
+        suppressed_frame_done.disconnect();
     });
 
     this->on_surface_commit.set_callback([=] (void*)
@@ -220,7 +277,11 @@ void wf::scene::wlr_surface_node_t::send_frame_done(bool delay_until_vblank)
     {
         timespec now;
         clock_gettime(CLOCK_MONOTONIC, &now);
-        wlr_surface_send_frame_done(surface, &now);
+        const int64_t now_us = now.tv_sec * 1000000ll + now.tv_nsec / 1000;
+        if (!suppress_frame_done(now_us))
+        {
+            release_frame_callbacks(now_us);
+        }
     } else
     {
         for (auto& [wo, _] : visibility)
@@ -230,6 +291,46 @@ void wf::scene::wlr_surface_node_t::send_frame_done(bool delay_until_vblank)
     }
 }
 
+bool wf::scene::wlr_surface_node_t::suppress_frame_done(int64_t now_us)
+{
+    auto cap = find_frame_rate_cap(surface);
+    if (!cap)
+    {
+        return false;
+    }
+
+    const int64_t next_frame_us = last_frame_done_us + 1000000 / cap->max_fps;
+    if (now_us >= next_frame_us)
+    {
+        return false;
+    }
+
+    ++cap->suppressed;
+    if (!suppressed_frame_done.is_connected())
+    {
+        // The client waits for the frame done event, so the output may not repaint until it is sent.
+        suppressed_frame_done.set_timeout((next_frame_us - now_us + 999) / 1000, [=] ()
+        {
+            timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            release_frame_callbacks(now.tv_sec * 1000000ll + now.tv_nsec / 1000);
+        });
+    }
+
+    return true;
+}
+
+void wf::scene::wlr_surface_node_t::release_frame_callbacks(int64_t now_us)
+{
+    suppressed_frame_done.disconnect();
+    last_frame_done_us = now_us;
+
+    timespec now;
+    now.tv_sec  = now_us / 1000000;
+    now.tv_nsec = (now_us % 1000000) * 1000;
+    wlr_surface_send_frame_done(surface, &now);
+}
+
 class wf::scene::wlr_surface_node_t::wlr_surface_render_instance_t : public render_instance_t
 {
     std::shared_ptr<wlr_surface_node_t> self;
@@ -1,5 +1,6 @@
 #include "xdg-toplevel.hpp"
 #include "wayfire/core.hpp"
+#include "wayfire/debug.hpp"
 #include <memory>
 #include <wayfire/txn/transaction-manager.hpp>
 #include <wlr/util/edges.h>
@@ -106,6 +107,18 @@ void wf::xdg_toplevel_t::commit()
     }
 }
 
+wf::txn::client_info_t wf::xdg_toplevel_t::get_client_info() const
+{
+    wf::txn::client_info_t info;
+    if (toplevel)
+    {
+        info.app_id = nonull(toplevel->app_id);
+        wl_client_get_credentials(wl_resource_get_client(toplevel->resource), &info.pid, NULL, NULL);
+    }
+
+    return info;
+}
+
 void wf::xdg_toplevel_t::apply()
 {
     xdg_toplevel_applied_state_signal event_applied;
@@ -24,6 +24,7 @@ class xdg_toplevel_t : public toplevel_t, public std::enable_shared_from_this<xd
         std::shared_ptr<wf::scene::wlr_surface_node_t> surface);
     void commit() override;
     void apply() override;
+    wf::txn::client_info_t get_client_info() const override;
     wf::geometry_t calculate_base_geometry();
     void request_native_size();
 
@@ -159,6 +159,18 @@ void wf::xw::xwayland_toplevel_t::reconfigure_xwayland_surface()
     wlr_xwayland_surface_configure(xw, configure.x, configure.y, configure.width, configure.height);
 }
 
+wf::txn::client_info_t wf::xw::xwayland_toplevel_t::get_client_info() const
+{
+    wf::txn::client_info_t info;
+    if (xw)
+    {
+        info.app_id = nonull(xw->class_t);
+        info.pid    = xw->pid;
+    }
+
+    return info;
+}
+
 void wf::xw::xwayland_toplevel_t::apply()
 {
     xwayland_toplevel_applied_state_signal event_applied;
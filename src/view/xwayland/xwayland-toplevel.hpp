@@ -28,6 +28,7 @@ class xwayland_toplevel_t : public wf::toplevel_t, public std::enable_shared_fro
     xwayland_toplevel_t(wlr_xwayland_surface *xw);
     void commit() override;
     void apply() override;
+    wf::txn::client_info_t get_client_info() const override;
 
     wf::dimensions_t get_min_size() override;
     wf::dimensions_t get_max_size() override;
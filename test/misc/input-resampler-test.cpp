@@ -0,0 +1,76 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <wayfire/input-resampler.hpp>
+
+TEST_CASE("Resampling without samples")
+{
+    wf::input_resampler_t resampler;
+    REQUIRE(resampler.empty());
+    REQUIRE(resampler.get_sample_interval() == 0);
+    REQUIRE(resampler.sample_at(100).x == 0.0);
+    REQUIRE(resampler.sample_at(100).y == 0.0);
+}
+
+TEST_CASE("Interpolation between samples")
+{
+    wf::input_resampler_t resampler;
+    resampler.add_sample(100, {0, 0});
+    resampler.add_sample(110, {10, 20});
+    resampler.add_sample(130, {30, 20});
+
+    REQUIRE(resampler.get_sample_interval() == 15);
+    REQUIRE(resampler.sample_at(90).x == doctest::Approx(0));
+    REQUIRE(resampler.sample_at(105).x == doctest::Approx(5));
+    REQUIRE(resampler.sample_at(105).y == doctest::Approx(10));
+    REQUIRE(resampler.sample_at(110).x == doctest::Approx(10));
+    REQUIRE(resampler.sample_at(125).x == doctest::Approx(25));
+    REQUIRE(resampler.sample_at(125).y == doctest::Approx(20));
+
+    // No prediction
+    REQUIRE(resampler.sample_at(140).x == doctest::Approx(30));
+}
+
+TEST_CASE("Extrapolation is limited")
+{
+    wf::input_resampler_t resampler{5};
+    resampler.add_sample(100, {0, 0});
+    resampler.add_sample(110, {10, -10});
+
+    REQUIRE(resampler.sample_at(113).x == doctest::Approx(13));
+    REQUIRE(resampler.sample_at(113).y == doctest::Approx(-13));
+    REQUIRE(resampler.sample_at(150).x == doctest::Approx(15));
+
+    resampler.set_max_prediction(0);
+    REQUIRE(resampler.sample_at(113).x == doctest::Approx(10));
+}
+
+TEST_CASE("Out of order samples and history")
+{
+    wf::input_resampler_t resampler;
+    resampler.add_sample(100, {0, 0});
+    resampler.add_sample(110, {10, 0});
+    resampler.add_sample(105, {100, 0});
+    resampler.add_sample(110, {20, 0});
+    REQUIRE(resampler.get_latest().x == doctest::Approx(20));
+    REQUIRE(resampler.sample_at(105).x == doctest::Approx(10));
+
+    for (int i = 2; i < 10; i++)
+    {
+        resampler.add_sample(100 + 10 * i, {10.0 * i, 0});
+    }
+
+    // Only the newest samples are kept
+    REQUIRE(resampler.sample_at(0).x == doctest::Approx(50));
+    REQUIRE(resampler.get_sample_interval() == 10);
+
+    resampler.reset();
+    REQUIRE(resampler.empty());
+}
+
+TEST_CASE("Event timestamps")
+{
+    const int64_t now = wf::get_current_time();
+    REQUIRE(wf::input_event_time_to_msec((uint32_t)now) == now);
+    REQUIRE(wf::input_event_time_to_msec((uint32_t)(now - 1000)) == now - 1000);
+}
@@ -0,0 +1,54 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <wayfire/latency-samples.hpp>
+
+TEST_CASE("Percentiles without samples")
+{
+    wf::latency_samples_t samples;
+    auto p = samples.get_percentiles();
+    REQUIRE(p.count == 0);
+    REQUIRE(p.p50_us == 0);
+    REQUIRE(p.max_us == 0);
+}
+
+TEST_CASE("Nearest-rank percentiles")
+{
+    wf::latency_samples_t samples;
+    for (int i = 100; i >= 1; i--)
+    {
+        samples.add(i * 10);
+    }
+
+    auto p = samples.get_percentiles();
+    REQUIRE(p.count == 100);
+    REQUIRE(p.p50_us == 500);
+    REQUIRE(p.p90_us == 900);
+    REQUIRE(p.p99_us == 990);
+    REQUIRE(p.max_us == 1000);
+
+    samples.add(5);
+    REQUIRE(samples.get_percentiles().p50_us == 500);
+
+    samples.reset();
+    REQUIRE(samples.get_percentiles().count == 0);
+}
+
+TEST_CASE("Only the most recent samples are kept")
+{
+    wf::latency_samples_t samples;
+    for (size_t i = 0; i < wf::latency_samples_t::CAPACITY; i++)
+    {
+        samples.add(1000000);
+    }
+
+    for (size_t i = 0; i < wf::latency_samples_t::CAPACITY; i++)
+    {
+        samples.add(1);
+    }
+
+    auto p = samples.get_percentiles();
+    REQUIRE(p.count == 2 * wf::latency_samples_t::CAPACITY);
+    REQUIRE(p.p99_us == 1);
+    REQUIRE(p.max_us == 1);
+}
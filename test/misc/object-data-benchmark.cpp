@@ -0,0 +1,53 @@
+#include <wayfire/object.hpp>
+
+#include <chrono>
+#include <cstdio>
+
+/**
+ * Measure the cost of looking up custom data on an object which holds a few pieces of data, as views
+ * usually do, by type and by name.
+ */
+static constexpr int NUM_LOOKUPS = 10000000;
+
+class bench_object_t : public wf::object_base_t
+{};
+
+template<int N>
+struct bench_data_t : public wf::custom_data_t
+{
+    int value = N;
+};
+
+template<class Lookup>
+static void run(const char *name, Lookup lookup)
+{
+    long sum   = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_LOOKUPS; i++)
+    {
+        sum += lookup();
+    }
+
+    auto end  = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::printf("%-24s %6.2f ns/lookup (checksum %ld)\n", name, ns / NUM_LOOKUPS, sum);
+}
+
+int main()
+{
+    bench_object_t object;
+    object.store_data(std::make_unique<bench_data_t<0>>());
+    object.store_data(std::make_unique<bench_data_t<1>>());
+    object.store_data(std::make_unique<bench_data_t<2>>());
+    object.store_data(std::make_unique<bench_data_t<3>>());
+    object.store_data(std::make_unique<bench_data_t<4>>(), "bench-named-data");
+    object.store_data(std::make_unique<bench_data_t<5>>());
+    object.store_data(std::make_unique<bench_data_t<6>>());
+    object.store_data(std::make_unique<bench_data_t<7>>());
+
+    run("get_data<T>()", [&] { return object.get_data<bench_data_t<7>>()->value; });
+    run("has_data<T>() (missing)", [&] { return (int)object.has_data<bench_data_t<8>>(); });
+    run("get_data<T>(name)", [&] { return object.get_data<bench_data_t<4>>("bench-named-data")->value; });
+    run("has_data(name) (missing)", [&] { return (int)object.has_data("bench-missing-data"); });
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include "../../plugins/animate/fire/particle.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+/**
+ * Measure how many fire particles per millisecond can be spawned and updated with 1..N threads.
+ * Since particles use counter-based random streams, the result must not depend on the number of threads.
+ */
+static constexpr int NUM_PARTICLES = 200000;
+static constexpr int NUM_FRAMES    = 200;
+
+static void init_particle(Particle& p, ParticleRandom& random)
+{
+    p.life = 1;
+    p.fade = random.uniform(0.1, 0.6);
+    p.color    = {random.uniform(0, 1), random.uniform(0, 1), random.uniform(0, 1), 1};
+    p.pos      = {random.uniform(0, 1000), random.uniform(490, 510)};
+    p.start_pos = p.pos;
+    p.speed    = {random.uniform(-10, 10), random.uniform(-25, 5)};
+    p.g = {-1, -3};
+    p.base_radius = p.radius = random.uniform(16, 24);
+}
+
+static double run(int threads, double& checksum)
+{
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+#endif
+
+    ParticleBuffer buffer{42};
+    buffer.set_initer(init_particle);
+    buffer.resize(NUM_PARTICLES);
+
+    long processed = 0;
+    auto start     = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_FRAMES; i++)
+    {
+        processed += buffer.spawn(NUM_PARTICLES / 10);
+        processed += buffer.alive();
+        buffer.update(1.0);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    checksum = std::accumulate(buffer.x.begin(), buffer.x.begin() + buffer.alive(), 0.0) +
+        std::accumulate(buffer.a.begin(), buffer.a.begin() + buffer.alive(), 0.0);
+
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    return processed / ms;
+}
+
+int main()
+{
+    int max_threads = 1;
+#ifdef _OPENMP
+    max_threads = omp_get_max_threads();
+#endif
+
+    double reference = 0;
+    for (int threads = 1; threads <= max_threads; threads++)
+    {
+        double checksum;
+        double rate = run(threads, checksum);
+        printf("%2d thread(s): %10.0f particles/ms\n", threads, rate);
+
+        if (threads == 1)
+        {
+            reference = checksum;
+        } else if (checksum != reference)
+        {
+            printf("Result with %d threads differs from the single-threaded result!\n", threads);
+            return 1;
+        }
+    }
+
+    return 0;
+}
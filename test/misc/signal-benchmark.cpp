@@ -0,0 +1,74 @@
+#include <wayfire/signal-provider.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+/**
+ * Measure the cost of emitting a signal depending on the number of connected listeners.
+ * The provider also has listeners for a few other signal types, as most objects in Wayfire do.
+ */
+static constexpr int NUM_EMITS = 1000000;
+
+struct bench_signal_t
+{
+    int value;
+};
+
+template<int N>
+struct other_signal_t
+{};
+
+template<int N>
+static void connect_other(wf::signal::provider_t& provider,
+    std::vector<std::unique_ptr<wf::signal::connection_base_t>>& connections)
+{
+    auto conn = std::make_unique<wf::signal::connection_t<other_signal_t<N>>>([] (other_signal_t<N>*) {});
+    provider.connect(conn.get());
+    connections.push_back(std::move(conn));
+}
+
+static void run(int listeners)
+{
+    wf::signal::provider_t provider;
+    std::vector<std::unique_ptr<wf::signal::connection_base_t>> connections;
+    connect_other<0>(provider, connections);
+    connect_other<1>(provider, connections);
+    connect_other<2>(provider, connections);
+
+    long sum = 0;
+    for (int i = 0; i < listeners; i++)
+    {
+        auto conn = std::make_unique<wf::signal::connection_t<bench_signal_t>>([&] (bench_signal_t *ev)
+        {
+            sum += ev->value;
+        });
+        provider.connect(conn.get());
+        connections.push_back(std::move(conn));
+    }
+
+    const int emits = NUM_EMITS / std::max(listeners, 1);
+    bench_signal_t ev{1};
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < emits; i++)
+    {
+        provider.emit(&ev);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::printf("%4d listeners: %8.1f ns/emit, %6.2f ns/listener (checksum %ld)\n",
+        listeners, ns / emits, ns / emits / std::max(listeners, 1), sum);
+}
+
+int main()
+{
+    for (int listeners : {0, 1, 4, 16, 64, 256})
+    {
+        run(listeners);
+    }
+
+    return 0;
+}
@@ -0,0 +1,172 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <wayfire/signal-provider.hpp>
+#include <string>
+#include <vector>
+
+struct test_signal
+{
+    int depth = 0;
+};
+
+struct other_signal
+{};
+
+TEST_CASE("Signals are emitted in connection order")
+{
+    wf::signal::provider_t provider;
+    std::vector<std::string> calls;
+
+    wf::signal::connection_t<test_signal> a = [&] (test_signal*) { calls.push_back("a"); };
+    wf::signal::connection_t<test_signal> b = [&] (test_signal*) { calls.push_back("b"); };
+    wf::signal::connection_t<other_signal> other = [&] (other_signal*) { calls.push_back("other"); };
+    provider.connect(&a);
+    provider.connect(&other);
+    provider.connect(&b);
+
+    test_signal data;
+    provider.emit(&data);
+    REQUIRE(calls == std::vector<std::string>{"a", "b"});
+}
+
+TEST_CASE("Disconnect the current and a later connection during emit")
+{
+    wf::signal::provider_t provider;
+    std::vector<std::string> calls;
+
+    wf::signal::connection_t<test_signal> a, b, c;
+    a = [&] (test_signal*) { calls.push_back("a"); };
+    b = [&] (test_signal*)
+    {
+        calls.push_back("b");
+        provider.disconnect(&b);
+        c.disconnect();
+    };
+    c = [&] (test_signal*) { calls.push_back("c"); };
+
+    provider.connect(&a);
+    provider.connect(&b);
+    provider.connect(&c);
+
+    test_signal data;
+    provider.emit(&data);
+    REQUIRE(calls == std::vector<std::string>{"a", "b"});
+    REQUIRE(a.is_connected());
+    REQUIRE(!b.is_connected());
+    REQUIRE(!c.is_connected());
+
+    calls.clear();
+    provider.emit(&data);
+    REQUIRE(calls == std::vector<std::string>{"a"});
+}
+
+TEST_CASE("Connections added during emit are called from the next emit")
+{
+    wf::signal::provider_t provider;
+    std::vector<std::string> calls;
+
+    wf::signal::connection_t<test_signal> a, b;
+    b = [&] (test_signal*) { calls.push_back("b"); };
+    a = [&] (test_signal*)
+    {
+        calls.push_back("a");
+        if (!b.is_connected())
+        {
+            provider.connect(&b);
+        }
+    };
+
+    provider.connect(&a);
+
+    test_signal data;
+    provider.emit(&data);
+    REQUIRE(calls == std::vector<std::string>{"a"});
+
+    calls.clear();
+    provider.emit(&data);
+    REQUIRE(calls == std::vector<std::string>{"a", "b"});
+}
+
+TEST_CASE("Nested emit of the same signal")
+{
+    wf::signal::provider_t provider;
+    std::vector<std::string> calls;
+
+    wf::signal::connection_t<test_signal> a, b, c;
+    a = [&] (test_signal *ev)
+    {
+        calls.push_back("a" + std::to_string(ev->depth));
+        if (ev->depth == 0)
+        {
+            test_signal nested;
+            nested.depth = 1;
+            provider.emit(&nested);
+        } else
+        {
+            // The outer emit is still running, so the list must not be compacted before it finishes.
+            provider.disconnect(&a);
+        }
+    };
+    b = [&] (test_signal *ev) { calls.push_back("b" + std::to_string(ev->depth)); };
+    c = [&] (test_signal *ev) { calls.push_back("c" + std::to_string(ev->depth)); };
+
+    provider.connect(&a);
+    provider.connect(&b);
+    provider.connect(&c);
+
+    test_signal data;
+    provider.emit(&data);
+    REQUIRE(calls == std::vector<std::string>{"a0", "a1", "b1", "c1", "b0", "c0"});
+
+    calls.clear();
+    provider.emit(&data);
+    REQUIRE(calls == std::vector<std::string>{"b0", "c0"});
+}
+
+TEST_CASE("Connections connected to several providers")
+{
+    wf::signal::provider_t first, second;
+    int calls = 0;
+
+    wf::signal::connection_t<test_signal> conn = [&] (test_signal*) { calls++; };
+    first.connect(&conn);
+    second.connect(&conn);
+
+    test_signal data;
+    first.emit(&data);
+    second.emit(&data);
+    REQUIRE(calls == 2);
+
+    // Disconnecting from one provider keeps the other connection.
+    first.disconnect(&conn);
+    REQUIRE(conn.is_connected());
+    first.emit(&data);
+    second.emit(&data);
+    REQUIRE(calls == 3);
+
+    // Disconnecting during an emit of one provider also disconnects from the others.
+    first.connect(&conn);
+    conn.set_callback([&] (test_signal*)
+    {
+        calls++;
+        conn.disconnect();
+    });
+    first.emit(&data);
+    REQUIRE(calls == 4);
+    REQUIRE(!conn.is_connected());
+    first.emit(&data);
+    second.emit(&data);
+    REQUIRE(calls == 4);
+
+    // Destroying a provider disconnects it from its connections.
+    {
+        wf::signal::provider_t temporary;
+        temporary.connect(&conn);
+        second.connect(&conn);
+    }
+
+    REQUIRE(conn.is_connected());
+    second.emit(&data);
+    REQUIRE(calls == 5);
+}
@@ -0,0 +1,134 @@
+#include "../../plugins/window-rules/rule-set.hpp"
+
+#include <wayfire/lexer/lexer.hpp>
+#include <wayfire/parser/rule_parser.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+
+/**
+ * Measure the cost of applying the window rules for a newly mapped view depending on the number of rules,
+ * once by evaluating every rule as window-rules used to, and once through the indexed rule set.
+ * Most rules match on the app-id, as is typical for window rules, the others on the title or other signals.
+ */
+static constexpr int NUM_APPLIES = 2000;
+
+class bench_access_interface_t : public wf::access_interface_t
+{
+  public:
+    std::map<std::string, wf::variant_t> properties;
+    long lookups = 0;
+
+    wf::variant_t get(const std::string & identifier, bool & error) override
+    {
+        ++lookups;
+        auto it = properties.find(identifier);
+        error = (it == properties.end());
+        return error ? wf::variant_t{std::string("")} : it->second;
+    }
+};
+
+class bench_action_interface_t : public wf::action_interface_t
+{
+  public:
+    long executed = 0;
+
+    bool execute(const std::string & name, const std::vector<wf::variant_t> & args) override
+    {
+        ++executed;
+        return false;
+    }
+};
+
+static std::string make_rule(int i)
+{
+    const std::string n = std::to_string(i);
+    switch (i % 10)
+    {
+      case 0:
+        return "on created if title is \"document-" + n + "\" then minimize";
+
+      case 1:
+        return "on maximized if app_id is \"app-" + n + "\" then minimize";
+
+      default:
+        return "on created if app_id is \"app-" + n + "\" & type is \"toplevel\" then maximize";
+    }
+}
+
+template<class Apply>
+static double measure(Apply apply)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_APPLIES; i++)
+    {
+        apply();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / NUM_APPLIES;
+}
+
+static void run(int num_rules)
+{
+    std::vector<std::shared_ptr<wf::rule_t>> all_rules;
+    wf::window_rule_set_t rule_set;
+    wf::lexer_t lexer;
+    for (int i = 0; i < num_rules; i++)
+    {
+        auto text = make_rule(i);
+        lexer.reset(text);
+        auto rule = wf::rule_parser_t().parse(lexer);
+        if (rule == nullptr)
+        {
+            std::printf("Failed to parse rule %s\n", text.c_str());
+            continue;
+        }
+
+        all_rules.push_back(rule);
+        rule_set.add(rule, text);
+    }
+
+    bench_access_interface_t access;
+    access.properties["app_id"] = std::string("app-" + std::to_string(num_rules / 2 + 2));
+    access.properties["title"]  = std::string("Untitled");
+    access.properties["type"]   = std::string("toplevel");
+    bench_action_interface_t action;
+
+    double linear = measure([&] ()
+    {
+        for (auto& rule : all_rules)
+        {
+            rule->apply("created", access, action);
+        }
+    });
+    long linear_lookups = access.lookups;
+    long linear_actions = action.executed;
+
+    access.lookups  = 0;
+    action.executed = 0;
+    wf::cached_access_interface_t cached_access{access};
+    wf::invalidating_action_interface_t cached_action{action, cached_access};
+    double indexed = measure([&] ()
+    {
+        cached_access.invalidate();
+        rule_set.for_each_candidate("created", "app-" + std::to_string(num_rules / 2 + 2),
+            [&] (wf::rule_t& rule) { rule.apply("created", cached_access, cached_action); });
+    });
+
+    std::printf("%5d rules: linear %8.2f us/apply (%5.1f lookups), indexed %8.2f us/apply (%5.1f lookups)"
+                ", actions %ld/%ld\n", num_rules,
+        linear, (double)linear_lookups / NUM_APPLIES, indexed, (double)access.lookups / NUM_APPLIES,
+        linear_actions, action.executed);
+}
+
+int main()
+{
+    for (int num_rules : {10, 30, 100, 300, 1000})
+    {
+        run(num_rules);
+    }
+
+    return 0;
+}
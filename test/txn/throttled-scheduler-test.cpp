@@ -0,0 +1,162 @@
+#include "wayfire/txn/transaction-manager.hpp"
+#include "wayfire/txn/throttled-scheduler.hpp"
+#include "wayfire/util.hpp"
+#include <wayfire/util/log.hpp>
+#include <wayland-server-core.h>
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include "transaction-test-object.hpp"
+#include <wayfire/txn/transaction.hpp>
+
+static wf::txn::transaction_uptr new_tx()
+{
+    return std::make_unique<wf::txn::transaction_t>(0, [] (auto, auto) {});
+}
+
+/**
+ * A stand-in for a client which is resized interactively: each commit sends a configure with the pending
+ * size, and the client acks configures only when the test says so.
+ */
+class slow_client_t : public txn_test_object_t
+{
+  public:
+    int pending_size = 0;
+    int current_size = 0;
+    std::vector<int> configures;
+
+    slow_client_t() : txn_test_object_t(false)
+    {}
+
+    void commit() override
+    {
+        txn_test_object_t::commit();
+        configures.push_back(pending_size);
+    }
+
+    void apply() override
+    {
+        txn_test_object_t::apply();
+        current_size = configures.back();
+    }
+
+    // Ack the last configure.
+    void ack()
+    {
+        emit_ready();
+    }
+};
+
+TEST_CASE("Requests are deferred while a transaction is in flight")
+{
+    setup_wayfire_debugging_state();
+    wf::txn::transaction_manager_t manager;
+    auto client = std::make_shared<slow_client_t>();
+    wf::txn::throttled_scheduler_t scheduler{manager, client, new_tx};
+
+    client->pending_size = 1;
+    scheduler.schedule();
+    REQUIRE(client->configures == std::vector<int>{1});
+    REQUIRE(scheduler.is_in_flight());
+    REQUIRE(!scheduler.has_deferred());
+
+    // Many motion events, while the client is still busy
+    for (int i = 2; i <= 10; i++)
+    {
+        client->pending_size = i;
+        scheduler.schedule();
+    }
+
+    REQUIRE(client->configures == std::vector<int>{1});
+    REQUIRE(scheduler.has_deferred());
+    REQUIRE(!manager.is_object_pending(client));
+
+    // When the client acks, it immediately gets the latest size
+    client->ack();
+    REQUIRE(client->current_size == 1);
+    REQUIRE(client->configures == std::vector<int>{1, 10});
+    REQUIRE(!scheduler.has_deferred());
+
+    client->ack();
+    REQUIRE(client->current_size == 10);
+    REQUIRE(!scheduler.is_in_flight());
+    wl_event_loop_dispatch_idle(wf::wl_idle_call::loop);
+}
+
+TEST_CASE("A slow client gets one configure per ack")
+{
+    setup_wayfire_debugging_state();
+    wf::txn::transaction_manager_t manager;
+    auto client = std::make_shared<slow_client_t>();
+    wf::txn::throttled_scheduler_t scheduler{manager, client, new_tx};
+
+    // 200 motion events, the client needs the time of 8 events to handle a configure.
+    for (int i = 1; i <= 200; i++)
+    {
+        client->pending_size = i;
+        scheduler.schedule();
+        REQUIRE(!manager.is_object_pending(client));
+        if (i % 8 == 0)
+        {
+            client->ack();
+        }
+    }
+
+    REQUIRE(client->configures.size() == 26);
+    REQUIRE(client->configures.back() == 200);
+    REQUIRE(std::is_sorted(client->configures.begin(), client->configures.end()));
+
+    client->ack();
+    REQUIRE(client->current_size == 200);
+    REQUIRE(!scheduler.is_in_flight());
+    wl_event_loop_dispatch_idle(wf::wl_idle_call::loop);
+}
+
+TEST_CASE("Flushing schedules deferred requests immediately")
+{
+    setup_wayfire_debugging_state();
+    wf::txn::transaction_manager_t manager;
+    auto client = std::make_shared<slow_client_t>();
+    auto scheduler = std::make_unique<wf::txn::throttled_scheduler_t>(manager, client, new_tx);
+
+    client->pending_size = 1;
+    scheduler->schedule();
+    client->pending_size = 2;
+    scheduler->schedule();
+    REQUIRE(scheduler->has_deferred());
+
+    scheduler->flush();
+    REQUIRE(!scheduler->has_deferred());
+    REQUIRE(manager.is_object_pending(client));
+
+    // The scheduler is not needed for the pending transaction to go through.
+    scheduler.reset();
+    client->ack();
+    REQUIRE(client->configures == std::vector<int>{1, 2});
+    client->ack();
+    REQUIRE(client->current_size == 2);
+    wl_event_loop_dispatch_idle(wf::wl_idle_call::loop);
+}
+
+TEST_CASE("Transactions from other sources are waited for")
+{
+    setup_wayfire_debugging_state();
+    wf::txn::transaction_manager_t manager;
+    auto client = std::make_shared<slow_client_t>();
+    wf::txn::throttled_scheduler_t scheduler{manager, client, new_tx};
+
+    auto tx = new_tx();
+    tx->add_object(client);
+    manager.schedule_transaction(std::move(tx));
+
+    client->pending_size = 5;
+    scheduler.schedule();
+    REQUIRE(scheduler.has_deferred());
+    REQUIRE(client->configures == std::vector<int>{0});
+
+    client->ack();
+    REQUIRE(client->configures == std::vector<int>{0, 5});
+    client->ack();
+    REQUIRE(client->current_size == 5);
+    wl_event_loop_dispatch_idle(wf::wl_idle_call::loop);
+}
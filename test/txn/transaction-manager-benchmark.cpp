@@ -0,0 +1,132 @@
+#include "wayfire/txn/transaction-manager.hpp"
+#include "wayfire/util.hpp"
+#include <wayfire/util/log.hpp>
+#include <wayland-server-core.h>
+
+#include "transaction-test-object.hpp"
+#include <wayfire/txn/transaction.hpp>
+#include "../../src/core/txn/transaction-manager-impl.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+/**
+ * Measure the cost of scheduling transactions in the patterns produced by a large relayout, for increasing
+ * numbers of objects. The time per object should stay (roughly) constant.
+ */
+using objects_t = std::vector<std::shared_ptr<txn_test_object_t>>;
+
+static wf::txn::transaction_uptr new_tx()
+{
+    return std::make_unique<wf::txn::transaction_t>(0, [] (auto, auto) {});
+}
+
+static objects_t make_objects(int count)
+{
+    objects_t objects;
+    for (int i = 0; i < count; i++)
+    {
+        objects.push_back(std::make_shared<txn_test_object_t>(false));
+    }
+
+    return objects;
+}
+
+// Block all objects with a single committed transaction, so that the following transactions stay pending.
+static void block_objects(wf::txn::transaction_manager_t::impl& mgr, const objects_t& objects)
+{
+    auto tx = new_tx();
+    for (auto& obj : objects)
+    {
+        tx->add_object(obj);
+    }
+
+    mgr.schedule_transaction(std::move(tx));
+}
+
+// Make all objects ready until no transaction is left.
+static void drain(wf::txn::transaction_manager_t::impl& mgr, const objects_t& objects)
+{
+    while (!mgr.committed.empty())
+    {
+        for (auto& obj : objects)
+        {
+            if (mgr.committed_owner.count(obj.get()))
+            {
+                obj->emit_ready();
+            }
+        }
+    }
+
+    wl_event_loop_dispatch_idle(wf::wl_idle_call::loop);
+}
+
+/**
+ * Every view gets its own transaction while the previous layout is still committed, and then one transaction
+ * for the whole workspace merges all of them.
+ */
+static void relayout(wf::txn::transaction_manager_t::impl& mgr, const objects_t& objects)
+{
+    block_objects(mgr, objects);
+    for (auto& obj : objects)
+    {
+        auto tx = new_tx();
+        tx->add_object(obj);
+        mgr.schedule_transaction(std::move(tx));
+    }
+
+    auto tx = new_tx();
+    for (auto& obj : objects)
+    {
+        tx->add_object(obj);
+    }
+
+    mgr.schedule_transaction(std::move(tx));
+    drain(mgr, objects);
+}
+
+/**
+ * Neighbouring views are resized together (as when dragging a tiling split), which chains all pending
+ * transactions into one.
+ */
+static void chain(wf::txn::transaction_manager_t::impl& mgr, const objects_t& objects)
+{
+    block_objects(mgr, objects);
+    for (size_t i = 0; i + 1 < objects.size(); i++)
+    {
+        auto tx = new_tx();
+        tx->add_object(objects[i]);
+        tx->add_object(objects[i + 1]);
+        mgr.schedule_transaction(std::move(tx));
+    }
+
+    drain(mgr, objects);
+}
+
+template<class Scenario>
+static void run(const char *name, Scenario scenario)
+{
+    for (int count : {50, 500, 5000, 50000})
+    {
+        wf::txn::transaction_manager_t::impl mgr;
+        auto objects = make_objects(count);
+
+        auto start = std::chrono::steady_clock::now();
+        scenario(mgr, objects);
+        auto end = std::chrono::steady_clock::now();
+
+        double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        std::printf("%-10s %6d objects: %10.3f ms, %8.1f ns/object\n", name, count, ns / 1e6, ns / count);
+    }
+}
+
+int main()
+{
+    wf::log::initialize_logging(std::cout, wf::log::LOG_LEVEL_ERROR, wf::log::LOG_COLOR_MODE_OFF);
+    wf::wl_idle_call::loop = wl_event_loop_create();
+
+    run("relayout", relayout);
+    run("chain", chain);
+    return 0;
+}